@@ -7,14 +7,43 @@
 // only for std::less<T>
 #include <functional>
 #include <cstddef>
+#include <string>
+#include <utility>
 #include "utility.hpp"
 #include "exceptions.hpp"
+#ifdef SJTU_TRACK_ALLOCATIONS
+#include "tracking_allocator.hpp"
+#endif
 
 namespace sjtu {
 enum Colour {
   kRed, kBlack
 };
 
+/**
+ * counters of the work done by a map, kept when SJTU_CONTAINER_STATS is defined (see map::stats()).
+ *   - comparisons: the calls of KeyCompare;
+ *   - single_rotations / double_rotations: the rebalancing rotations, LL and RR / LR and RL;
+ *   - descents, descent_depth_total, descent_depth_max: the walks from the root made by lookups, insertions and
+ *     erasures, and the total and largest number of nodes visited by one of them.
+ */
+struct map_stats {
+  size_t comparisons = 0;
+  size_t single_rotations = 0;
+  size_t double_rotations = 0;
+  size_t descents = 0;
+  size_t descent_depth_total = 0;
+  size_t descent_depth_max = 0;
+
+  std::string to_json() const {
+    return "{\"comparisons\": " + std::to_string(comparisons) + ", \"single_rotations\": " +
+           std::to_string(single_rotations) + ", \"double_rotations\": " + std::to_string(double_rotations) +
+           ", \"descents\": " + std::to_string(descents) + ", \"descent_depth_total\": " +
+           std::to_string(descent_depth_total) + ", \"descent_depth_max\": " + std::to_string(descent_depth_max) +
+           "}";
+  }
+};
+
 template<class Key, class T, class KeyCompare = std::less<Key>>
 class map {
 private:
@@ -28,21 +57,39 @@ private:
         data_(data), colour_(colour), parent_(parent), left_(left), right_(right) {}
   };
 
+  // allocate / free a node, through allocation_tracker if SJTU_TRACK_ALLOCATIONS is defined.
+  template<class... Args>
+  static RBTreeNode *NewNode(Args &&... args) {
+#ifdef SJTU_TRACK_ALLOCATIONS
+    return tracked_new<RBTreeNode>(std::forward<Args>(args)...);
+#else
+    return new RBTreeNode(std::forward<Args>(args)...);
+#endif
+  }
+
+  static void DeleteNode(RBTreeNode *node) {
+#ifdef SJTU_TRACK_ALLOCATIONS
+    tracked_delete(node);
+#else
+    delete node;
+#endif
+  }
+
   static void ClearTree(RBTreeNode *root) {
     if (root == nullptr) {
       return;
     }
     ClearTree(root->left_);
     ClearTree(root->right_);
-    delete root;
+    DeleteNode(root);
   }
 
   static RBTreeNode *CopyTree(const RBTreeNode *other_root) {
     if (other_root == nullptr) {
       return nullptr;
     }
-    RBTreeNode *now_root = new RBTreeNode(other_root->data_, other_root->colour_, nullptr, CopyTree(other_root->left_),
-                                          CopyTree(other_root->right_));
+    RBTreeNode *now_root = NewNode(other_root->data_, other_root->colour_, nullptr, CopyTree(other_root->left_),
+                                   CopyTree(other_root->right_));
     if (now_root->left_ != nullptr) {
       now_root->left_->parent_ = now_root;
     }
@@ -92,7 +139,33 @@ private:
     return node->parent_;
   }
 
+  // compare two keys with KeyCompare. it and the two below record into stats_ if SJTU_CONTAINER_STATS is defined.
+  bool Less(const Key &lhs, const Key &rhs) const {
+#ifdef SJTU_CONTAINER_STATS
+    stats_.comparisons++;
+#endif
+    return KeyCompare()(lhs, rhs);
+  }
+
+  void CountRotation([[maybe_unused]] bool is_double) {
+#ifdef SJTU_CONTAINER_STATS
+    (is_double ? stats_.double_rotations : stats_.single_rotations)++;
+#endif
+  }
+
+  // record a walk from the root that visited `depth` nodes.
+  void CountDescent([[maybe_unused]] size_t depth) const {
+#ifdef SJTU_CONTAINER_STATS
+    stats_.descents++;
+    stats_.descent_depth_total += depth;
+    if (depth > stats_.descent_depth_max) {
+      stats_.descent_depth_max = depth;
+    }
+#endif
+  }
+
   void LL(RBTreeNode *&g) {
+    CountRotation(false);
     RBTreeNode *g_par = g->parent_, *p = g->left_, *p_r = p->right_;
     p->right_ = g;
     g->parent_ = p;
@@ -121,6 +194,7 @@ private:
   }
 
   void RR(RBTreeNode *g) {
+    CountRotation(false);
     RBTreeNode *g_par = g->parent_, *p = g->right_, *p_l = p->left_;
     p->left_ = g;
     g->parent_ = p;
@@ -149,6 +223,7 @@ private:
   }
 
   void LR(RBTreeNode *g) {
+    CountRotation(true);
     RBTreeNode *g_par = g->parent_, *p = g->left_, *x = p->right_, *x_l = x->left_, *x_r = x->right_;
     g->parent_ = x;
     g->left_ = x_r;
@@ -183,6 +258,7 @@ private:
   }
 
   void RL(RBTreeNode *g) {
+    CountRotation(true);
     RBTreeNode *g_par = g->parent_, *p = g->right_, *x = p->left_, *x_l = x->left_, *x_r = x->right_;
     g->parent_ = x;
     g->right_ = x_l;
@@ -218,18 +294,20 @@ private:
 
   pair<RBTreeNode *, bool> InsertNode(const pair<const Key, T> &value) {
     if (root_ == nullptr) {
-      root_ = new RBTreeNode(value, kBlack);
+      root_ = NewNode(value, kBlack);
       return {root_, true};
     }
     RBTreeNode *now = root_, *res;
+    size_t depth = 1;
     while (true) {
-      bool is_smaller = KeyCompare()(value.first, now->data_.first);
-      bool is_bigger = KeyCompare()(now->data_.first, value.first);
+      bool is_smaller = Less(value.first, now->data_.first);
+      bool is_bigger = Less(now->data_.first, value.first);
       if (!is_smaller && !is_bigger) {
+        CountDescent(depth);
         return {now, false};
       }
       if (is_smaller && now->left_ == nullptr) {
-        now->left_ = new RBTreeNode(value, kRed, now);
+        now->left_ = NewNode(value, kRed, now);
         res = now->left_;
         if (now->colour_ == kBlack) {
           break;
@@ -243,7 +321,7 @@ private:
         break;
       }
       if (is_bigger && now->right_ == nullptr) {
-        now->right_ = new RBTreeNode(value, kRed, now);
+        now->right_ = NewNode(value, kRed, now);
         res = now->right_;
         if (now->colour_ == kBlack) {
           break;
@@ -286,7 +364,9 @@ private:
         }
       }
       now = (is_smaller ? now->left_ : now->right_);
+      depth++;
     }
+    CountDescent(depth);
     root_->colour_ = kBlack;
     return {res, true};
   }
@@ -294,10 +374,11 @@ private:
   void EraseNode(RBTreeNode *node) {
     if (size_ == 1) {
       root_ = nullptr;
-      delete node;
+      DeleteNode(node);
       return;
     }
     RBTreeNode *now = root_;
+    size_t depth = 1;
     bool find_substitution = false;
     while (true) {
       while (true) {
@@ -371,8 +452,9 @@ private:
           }
           break;
         }
-        bool is_smaller = (find_substitution || KeyCompare()(node->data_.first, now->data_.first));
+        bool is_smaller = (find_substitution || Less(node->data_.first, now->data_.first));
         now = (is_smaller ? now->left_ : now->right_);
+        depth++;
         if (now->colour_ == kRed) {
           break;
         }
@@ -426,6 +508,7 @@ private:
         }
         find_substitution = true;
         now = now->right_;
+        depth++;
         continue;
       }
       if (find_substitution && now->left_ == nullptr) {
@@ -468,26 +551,35 @@ private:
         now->colour_ = node->colour_;
         break;
       }
-      now = (find_substitution || KeyCompare()(node->data_.first, now->data_.first) ? now->left_ : now->right_);
+      now = (find_substitution || Less(node->data_.first, now->data_.first) ? now->left_ : now->right_);
+      depth++;
     }
+    CountDescent(depth);
     root_->colour_ = kBlack;
-    delete node;
+    DeleteNode(node);
   }
 
   RBTreeNode *FindNode(const Key &key) const {
     RBTreeNode *now = root_;
+    size_t depth = 0;
     while (now != nullptr) {
-      bool is_smaller = KeyCompare()(key, now->data_.first), is_bigger = KeyCompare()(now->data_.first, key);
+      depth++;
+      bool is_smaller = Less(key, now->data_.first), is_bigger = Less(now->data_.first, key);
       if (!is_smaller && !is_bigger) {
+        CountDescent(depth);
         return now;
       }
       now = (is_smaller ? now->left_ : now->right_);
     }
+    CountDescent(depth);
     return nullptr;
   }
 
   RBTreeNode *root_, *min_node_, *max_node_;
   size_t size_;
+#ifdef SJTU_CONTAINER_STATS
+  mutable map_stats stats_;
+#endif
 
 public:
   /**
@@ -795,7 +887,7 @@ public:
     if (res == nullptr) {
       res = InsertNode(pair<const Key, T>(key, T())).first;
       size_++;
-      if (min_node_ == nullptr || KeyCompare()(res->data_.first, min_node_->data_.first)) {
+      if (min_node_ == nullptr || Less(res->data_.first, min_node_->data_.first)) {
         min_node_ = res;
       }
     }
@@ -872,10 +964,10 @@ public:
     pair<RBTreeNode *, bool> res = InsertNode(value);
     if (res.second) {
       size_++;
-      if (min_node_ == nullptr || KeyCompare()(value.first, min_node_->data_.first)) {
+      if (min_node_ == nullptr || Less(value.first, min_node_->data_.first)) {
         min_node_ = res.first;
       }
-      if (max_node_ == nullptr || KeyCompare()(max_node_->data_.first, value.first)) {
+      if (max_node_ == nullptr || Less(max_node_->data_.first, value.first)) {
         max_node_ = res.first;
       }
     }
@@ -925,6 +1017,25 @@ public:
   const_iterator find(const Key &key) const {
     return const_iterator(FindNode(key), this);
   }
+
+  /**
+   * returns the counters of this map since its construction or the last reset_stats().
+   * they are only kept when SJTU_CONTAINER_STATS is defined; otherwise they are all 0 and cost nothing.
+   * lookups through a const map are counted as well. the counters stay with the object and are not copied.
+   */
+  map_stats stats() const {
+#ifdef SJTU_CONTAINER_STATS
+    return stats_;
+#else
+    return map_stats();
+#endif
+  }
+
+  void reset_stats() {
+#ifdef SJTU_CONTAINER_STATS
+    stats_ = map_stats();
+#endif
+  }
 };
 
 }
@@ -3,10 +3,36 @@
 
 #include <cstddef>
 #include <functional>
+#include <string>
+#include <utility>
 #include "exceptions.hpp"
+#ifdef SJTU_TRACK_ALLOCATIONS
+#include "tracking_allocator.hpp"
+#endif
 
 namespace sjtu {
 
+/**
+ * counters of the work done by a priority_queue, kept when SJTU_CONTAINER_STATS is defined (see
+ *   priority_queue::stats()).
+ *   - comparisons: the calls of Compare;
+ *   - merges: the heap merges done by push, pop and merge;
+ *   - merge_path_total / merge_path_max: the total and largest number of nodes walked down the right paths of
+ *     the two heaps in a merge, which is the cost of the merge.
+ */
+struct priority_queue_stats {
+  size_t comparisons = 0;
+  size_t merges = 0;
+  size_t merge_path_total = 0;
+  size_t merge_path_max = 0;
+
+  std::string to_json() const {
+    return "{\"comparisons\": " + std::to_string(comparisons) + ", \"merges\": " + std::to_string(merges) +
+           ", \"merge_path_total\": " + std::to_string(merge_path_total) + ", \"merge_path_max\": " +
+           std::to_string(merge_path_max) + "}";
+  }
+};
+
 /**
  * a container like std::priority_queue which is a heap internal.
  */
@@ -47,12 +73,12 @@ public:
    * push new element to the priority queue.
    */
   void push(const T &e) {
-    Node *new_node = new Node(e);
+    Node *new_node = NewNode(e);
     try {
-      root_ = MergeTree(root_, new_node);
+      root_ = Merge(root_, new_node);
       size_++;
     } catch (...) {
-      delete new_node;
+      DeleteNode(new_node);
     }
   }
 
@@ -64,8 +90,8 @@ public:
     if (size_ == 0) {
       throw container_is_empty();
     }
-    Node *new_root = MergeTree(root_->left_, root_->right_);
-    delete root_;
+    Node *new_root = Merge(root_->left_, root_->right_);
+    DeleteNode(root_);
     root_ = new_root;
     size_--;
   }
@@ -90,12 +116,31 @@ public:
    * clear the other priority_queue.
    */
   void merge(priority_queue &other) {
-    root_ = MergeTree(root_, other.root_);
+    root_ = Merge(root_, other.root_);
     other.root_ = nullptr;
     size_ += other.size_;
     other.size_ = 0;
   }
 
+  /**
+   * returns the counters of this priority_queue since its construction or the last reset_stats().
+   * they are only kept when SJTU_CONTAINER_STATS is defined; otherwise they are all 0 and cost nothing.
+   * the counters stay with the object and are not copied with the contents.
+   */
+  priority_queue_stats stats() const {
+#ifdef SJTU_CONTAINER_STATS
+    return stats_;
+#else
+    return priority_queue_stats();
+#endif
+  }
+
+  void reset_stats() {
+#ifdef SJTU_CONTAINER_STATS
+    stats_ = priority_queue_stats();
+#endif
+  }
+
 private:
   struct Node {
     T data_;
@@ -105,11 +150,29 @@ private:
         : data_(data), left_(left), right_(right) {}
   };
 
+  // allocate / free a node, through allocation_tracker if SJTU_TRACK_ALLOCATIONS is defined.
+  template<class... Args>
+  static Node *NewNode(Args &&... args) {
+#ifdef SJTU_TRACK_ALLOCATIONS
+    return tracked_new<Node>(std::forward<Args>(args)...);
+#else
+    return new Node(std::forward<Args>(args)...);
+#endif
+  }
+
+  static void DeleteNode(const Node *node) {
+#ifdef SJTU_TRACK_ALLOCATIONS
+    tracked_delete(node);
+#else
+    delete node;
+#endif
+  }
+
   static Node *CopyTree(const Node *root) {
     if (root == nullptr) {
       return nullptr;
     }
-    return new Node(root->data_, CopyTree(root->left_), CopyTree(root->right_));
+    return NewNode(root->data_, CopyTree(root->left_), CopyTree(root->right_));
   }
 
   static void ClearTree(const Node *root) {
@@ -118,16 +181,36 @@ private:
     }
     ClearTree(root->left_);
     ClearTree(root->right_);
-    delete root;
+    DeleteNode(root);
   }
 
-  static Node *MergeTree(Node *root1, Node *root2) {
+  // merge two heaps, recording the length of the merge path. each step down the path makes one comparison.
+  Node *Merge(Node *root1, Node *root2) {
+#ifdef SJTU_CONTAINER_STATS
+    size_t comparisons = stats_.comparisons;
+    Node *res = MergeTree(root1, root2);
+    size_t path = stats_.comparisons - comparisons;
+    stats_.merges++;
+    stats_.merge_path_total += path;
+    if (path > stats_.merge_path_max) {
+      stats_.merge_path_max = path;
+    }
+    return res;
+#else
+    return MergeTree(root1, root2);
+#endif
+  }
+
+  Node *MergeTree(Node *root1, Node *root2) {
     if (root1 == nullptr) {
       return root2;
     }
     if (root2 == nullptr) {
       return root1;
     }
+#ifdef SJTU_CONTAINER_STATS
+    stats_.comparisons++;
+#endif
     if (Compare()(root1->data_, root2->data_)) {
       Node *new_root = MergeTree(root1, root2->right_);
       root2->right_ = root2->left_;
@@ -142,6 +225,9 @@ private:
 
   Node *root_;
   size_t size_;
+#ifdef SJTU_CONTAINER_STATS
+  priority_queue_stats stats_;
+#endif
 };
 
 }
@@ -0,0 +1,75 @@
+#include "vector.hpp"
+#include "allocator.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+template<class T, size_t Alignment>
+bool Aligned(const T *p)
+{
+	return reinterpret_cast<std::uintptr_t>(p) % Alignment == 0;
+}
+
+template<class T, size_t Alignment>
+void TestAlignment(const char *name)
+{
+	std::cout << "Testing " << name << " aligned to " << Alignment << " bytes..." << std::endl;
+	using Vector = sjtu::vector<T, sjtu::aligned_allocator<T, Alignment>>;
+	Vector v;
+	bool ok = true;
+	int checks = 0;
+	for (int i = 0; i < 5000; ++i) {
+		v.push_back(T(i));
+		ok = ok && Aligned<T, Alignment>(v.data());
+		++checks;
+	}
+	v.insert(v.begin() + 3, 1000, T(-1));
+	ok = ok && Aligned<T, Alignment>(v.data());
+	while (v.size() > 7) {
+		v.pop_back();
+		ok = ok && Aligned<T, Alignment>(v.data());
+		++checks;
+	}
+	v.shrink_to_fit();
+	Vector c(v), m(std::move(c));
+	Vector r(100, T(2));
+	r = v;
+	ok = ok && Aligned<T, Alignment>(v.data()) && Aligned<T, Alignment>(m.data()) && Aligned<T, Alignment>(r.data());
+	std::cout << ok << " " << checks << " " << v.size() << " " << v.capacity() << " " << m.size() << " " << r[3]
+	          << " " << r[6] << std::endl;
+}
+
+void TestStrings()
+{
+	std::cout << "Testing non-trivial elements..." << std::endl;
+	sjtu::vector<std::string, sjtu::aligned_allocator<std::string, 128>> v;
+	for (int i = 0; i < 300; ++i) {
+		v.push_back(std::to_string(i));
+	}
+	v.erase(v.begin(), v.begin() + 100);
+	std::cout << Aligned<std::string, 128>(v.data()) << " " << v.size() << " " << v.front() << " " << v.back()
+	          << std::endl;
+}
+
+void TestRebind()
+{
+	std::cout << "Testing rebinding..." << std::endl;
+	sjtu::aligned_allocator<char, 64> a;
+	sjtu::aligned_allocator<double, 64> b(a);
+	std::cout << (a == b) << " " << (a != b) << " " << sjtu::aligned_allocator<char, 16>::alignment << std::endl;
+	sjtu::vector<bool, sjtu::aligned_allocator<bool, 64>> flags(1000, true);
+	flags[10] = false;
+	flags.push_back(false);
+	std::cout << flags.size() << " " << flags.count() << std::endl;
+}
+
+int main()
+{
+	TestAlignment<float, 64>("float");
+	TestAlignment<double, 32>("double");
+	TestAlignment<long long, 4096>("long long");
+	TestStrings();
+	TestRebind();
+	return 0;
+}
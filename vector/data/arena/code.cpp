@@ -0,0 +1,98 @@
+#include "vector.hpp"
+#include "allocator.hpp"
+
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+template<class Vector>
+void Print(const Vector &v)
+{
+	std::cout << v.size() << ":";
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << " " << v[i];
+	}
+	std::cout << std::endl;
+}
+
+void TestArena()
+{
+	std::cout << "Testing vector on a monotonic_arena..." << std::endl;
+	sjtu::monotonic_arena arena(256);
+	sjtu::monotonic_arena_allocator<int> alloc(&arena);
+	{
+		sjtu::vector<int, sjtu::monotonic_arena_allocator<int>> v(alloc);
+		for (int i = 0; i < 100; ++i) {
+			v.push_back(i);
+		}
+		std::cout << v.size() << " " << v[99] << " " << (v.get_allocator() == alloc) << " "
+		          << (arena.bytes_allocated() >= 100 * sizeof(int)) << std::endl;
+		sjtu::vector<int, sjtu::monotonic_arena_allocator<int>> w(alloc);
+		w.push_back(-1);
+		w.push_back(-2);
+		std::istringstream in("10 20 30");
+		w.insert(1, std::istream_iterator<int>(in), std::istream_iterator<int>());
+		Print(w);
+		sjtu::vector<int, sjtu::monotonic_arena_allocator<int>> fill(3, 7, alloc);
+		fill.insert(fill.begin() + 1, v.begin(), v.begin() + 3);
+		Print(fill);
+	}
+	size_t before = arena.bytes_allocated();
+	arena.reset();
+	std::cout << before / sizeof(int) << " " << arena.bytes_allocated() << std::endl;
+	sjtu::monotonic_arena other(256);
+	sjtu::vector<std::string, sjtu::monotonic_arena_allocator<std::string>> a(&arena), b(&other);
+	a.push_back("arena");
+	b.push_back("other");
+	b.push_back("one");
+	a.swap(b);
+	std::cout << (a.get_allocator().arena() == &other) << " " << (b.get_allocator().arena() == &arena) << " "
+	          << a.size() << " " << b[0] << std::endl;
+	a = std::move(b);
+	std::cout << (a.get_allocator().arena() == &arena) << " " << a[0] << std::endl;
+	sjtu::vector<std::string, sjtu::monotonic_arena_allocator<std::string>> c(&other);
+	c = a;
+	std::cout << (c.get_allocator().arena() == &other) << " " << c[0] << std::endl;
+}
+
+void TestPool()
+{
+	std::cout << "Testing vector on a pool_resource..." << std::endl;
+	sjtu::pool_resource pool;
+	sjtu::pool_allocator<std::string> alloc(&pool);
+	const std::string *first;
+	{
+		sjtu::vector<std::string, sjtu::pool_allocator<std::string>> v(alloc);
+		v.reserve(16);
+		first = v.data();
+		for (int i = 0; i < 20; ++i) {
+			v.push_back(std::string(30, char('a' + i)));
+		}
+		v.erase(0, 10);
+		std::cout << v.size() << " " << v[0] << " " << (v.data() != first) << std::endl;
+		std::istringstream in("x y z");
+		v.insert(v.begin() + 1, std::istream_iterator<std::string>(in), std::istream_iterator<std::string>());
+		std::cout << v.size() << " " << v[1] << v[2] << v[3] << " " << v[4][0] << std::endl;
+	}
+	// the freed block of 16 strings is handed out again.
+	sjtu::vector<std::string, sjtu::pool_allocator<std::string>> w(alloc);
+	w.reserve(16);
+	std::cout << (w.data() == first) << std::endl;
+	sjtu::vector<double, sjtu::pool_allocator<double>> big(100000, 1.5, &pool);
+	big.push_back(2.5);
+	std::cout << big.size() << " " << big.back() << std::endl;
+	sjtu::vector<int, sjtu::pool_allocator<int>> a(&pool), b(alloc);
+	for (int i = 0; i < 1000; ++i) {
+		(i % 2 ? a : b).push_back(i);
+	}
+	a.swap(b);
+	std::cout << a[0] << " " << b[0] << " " << (a.get_allocator() == b.get_allocator()) << std::endl;
+}
+
+int main()
+{
+	TestArena();
+	TestPool();
+	return 0;
+}
@@ -0,0 +1,105 @@
+#include "vector.hpp"
+#include "soa_vector.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <tuple>
+
+void TestPacked()
+{
+	std::cout << "Testing packed vector<bool>..." << std::endl;
+	sjtu::vector<bool> v;
+	for (int i = 0; i < 200; ++i) {
+		v.push_back(i % 3 == 0 || i % 7 == 0);
+	}
+	std::cout << v.size() << " " << v.count() << std::endl;
+	for (size_t i = v.find_first(); i < v.size(); i = v.find_next(i)) {
+		std::cout << i << " ";
+	}
+	std::cout << std::endl;
+	v[1] = true;
+	v[0] = v[2];
+	v[5].flip();
+	std::cout << v[0] << v[1] << v[2] << v[5] << std::endl;
+	v.insert(v.begin() + 64, true);
+	v.erase(v.begin());
+	std::cout << v.size() << " " << v.count() << " " << v[63] << std::endl;
+	sjtu::vector<bool> w(v.size(), true);
+	w[10] = false;
+	sjtu::vector<bool> a = v & w, o = v | w, x = v ^ w;
+	std::cout << a.count() << " " << o.count() << " " << x.count() << std::endl;
+	w.flip();
+	std::cout << w.count() << " " << (a == v) << " " << (a != v) << std::endl;
+	while (!v.empty()) {
+		v.pop_back();
+	}
+	std::cout << v.size() << " " << v.count() << std::endl;
+}
+
+void TestWordBoundaries()
+{
+	std::cout << "Testing vector<bool> across word boundaries..." << std::endl;
+	sjtu::vector<bool> v(63, true);
+	v.push_back(false);
+	v.push_back(true);
+	std::cout << v.size() << " " << v.count() << " " << (v.capacity() % 64) << " " << v[63] << v[64] << std::endl;
+	v.resize(10);
+	v.resize(130, false);
+	std::cout << v.size() << " " << v.count() << " " << v.find_next(9) << std::endl;
+	v.resize(200, true);
+	std::cout << v.count() << " " << v.find_next(9) << " " << v.back() << std::endl;
+	v.erase(v.begin());
+	v.insert(v.begin() + 128, false);
+	std::cout << v.size() << " " << v.count() << " " << v[128] << v[129] << std::endl;
+	sjtu::vector<bool> copy(v.begin() + 100, v.end());
+	std::cout << copy.size() << " " << copy.count() << " "
+	          << std::count(copy.begin(), copy.end(), true) << " " << (copy.end() - copy.begin()) << std::endl;
+	const sjtu::vector<bool> &cv = v;
+	sjtu::vector<bool>::const_iterator it = v.begin();
+	std::cout << (it == cv.begin()) << " " << (cv.end() - it) << " " << *(it + 129) << std::endl;
+	try {
+		v.at(v.size());
+	} catch (const sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	v.clear();
+	std::cout << v.size() << " " << v.count() << " " << (v.find_first() == v.size()) << std::endl;
+}
+
+void TestSoaBool()
+{
+	std::cout << "Testing soa_vector with bool fields..." << std::endl;
+	sjtu::soa_vector<int, bool> s;
+	for (int i = 0; i < 20; ++i) {
+		s.push_back(i, i % 4 == 0);
+	}
+	s[1].get<1>() = true;
+	s[2].get<1>() = s[0].get<1>();
+	s.insert(3, std::make_tuple(-3, true));
+	s.erase(10);
+	for (size_t i = 0; i < s.size(); ++i) {
+		std::cout << s[i].get<0>() << ":" << s[i].get<1>() << " ";
+	}
+	std::cout << std::endl;
+	const sjtu::soa_vector<int, bool> &cs = s;
+	int flags = 0;
+	auto column = cs.column<1>();
+	for (size_t i = 0; i < column.size(); ++i) {
+		flags += column[i];
+	}
+	std::tuple<int, bool> row = cs.back();
+	std::cout << flags << " " << std::get<0>(row) << " " << std::get<1>(row) << std::endl;
+	sjtu::soa_vector<bool> only;
+	only.push_back(true);
+	only.push_back(false);
+	only[0] = only[1];
+	std::cout << only.size() << " " << only[0].get<0>() << only[1].get<0>() << std::endl;
+}
+
+int main()
+{
+	TestPacked();
+	TestWordBoundaries();
+	TestSoaBool();
+	return 0;
+}
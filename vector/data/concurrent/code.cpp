@@ -0,0 +1,242 @@
+#include "concurrent_vector.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// a stateful allocator that never propagates; it tags every block and checks that the same allocator frees it.
+template<class T>
+class tagged_allocator {
+public:
+	using value_type = T;
+	using propagate_on_container_copy_assignment = std::false_type;
+	using propagate_on_container_move_assignment = std::false_type;
+	using propagate_on_container_swap = std::false_type;
+	using is_always_equal = std::false_type;
+
+	int tag;
+
+	explicit tagged_allocator(int t) : tag(t) {}
+
+	template<class U>
+	tagged_allocator(const tagged_allocator<U> &other) : tag(other.tag) {}
+
+	T *allocate(size_t n)
+	{
+		int *p = static_cast<int *>(::operator new(n * sizeof(T) + 16));
+		*p = tag;
+		return reinterpret_cast<T *>(reinterpret_cast<char *>(p) + 16);
+	}
+
+	void deallocate(T *q, size_t)
+	{
+		int *p = reinterpret_cast<int *>(reinterpret_cast<char *>(q) - 16);
+		if (*p != tag) {
+			std::cout << "freed by the wrong allocator" << std::endl;
+		}
+		::operator delete(p);
+	}
+
+	template<class U>
+	bool operator==(const tagged_allocator<U> &rhs) const
+	{
+		return tag == rhs.tag;
+	}
+
+	template<class U>
+	bool operator!=(const tagged_allocator<U> &rhs) const
+	{
+		return tag != rhs.tag;
+	}
+};
+
+void TestConcurrentAppend()
+{
+	std::cout << "Testing concurrent appends..." << std::endl;
+	sjtu::concurrent_vector<long long> v;
+	const int threads = 4, per_thread = 50000;
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; ++t) {
+		workers.emplace_back([&v, t] {
+			for (int i = 0; i < per_thread; ++i) {
+				if (i % 100 == 0) {
+					sjtu::concurrent_vector<long long>::iterator it = v.grow_by(10, -1);
+					*it = (long long)t * per_thread + i;
+					i += 9;
+				} else {
+					sjtu::concurrent_vector<long long>::iterator it = v.push_back((long long)t * per_thread + i);
+					if (*it != (long long)t * per_thread + i) {
+						std::cout << "wrong element" << std::endl;
+					}
+				}
+			}
+		});
+	}
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+	std::vector<long long> all(v.begin(), v.end());
+	std::sort(all.begin(), all.end());
+	size_t filler = std::count(all.begin(), all.end(), -1LL);
+	all.erase(std::unique(all.begin(), all.end()), all.end());
+	std::cout << v.size() << " " << filler << " " << all.size() << " " << all.front() << " " << all.back()
+	          << std::endl;
+}
+
+// an element that can tell whether it was constructed: check is set from value by the constructor.
+struct Checked {
+	long long value, check;
+
+	explicit Checked(long long v) : value(v), check(~v) {}
+
+	bool Valid() const
+	{
+		return check == ~value;
+	}
+};
+
+void TestConcurrentRead()
+{
+	std::cout << "Testing reads concurrent with appends..." << std::endl;
+	sjtu::concurrent_vector<Checked> v;
+	const int threads = 3, per_thread = 100000;
+	std::atomic<int> running(threads);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; ++t) {
+		workers.emplace_back([&v, &running, t] {
+			for (int i = 0; i < per_thread; ++i) {
+				if (i % 1000 == 0) {
+					v.grow_by(50, Checked(-1));
+					i += 49;
+				} else {
+					v.emplace_back((long long)t * per_thread + i);
+				}
+				if (i % 1000 == 999) {
+					std::this_thread::yield();
+				}
+			}
+			--running;
+		});
+	}
+	size_t reads = 0, bad = 0, shrunk = 0, last = 0;
+	do {
+		size_t n = v.size();
+		if (n < last) {
+			++shrunk;
+		}
+		last = n;
+		if (n == 0) {
+			continue;
+		}
+		bad += !v.at(n - 1).Valid() + !v.back().Valid() + !v[n / 2].Valid();
+		size_t step = n / 16 + 1;
+		for (sjtu::concurrent_vector<Checked>::const_iterator it = v.cbegin(), end = v.cend(); it < end; it += step) {
+			bad += !it->Valid();
+		}
+		++reads;
+	} while (running > 0);
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+	for (const Checked &c : v) {
+		bad += !c.Valid();
+	}
+	std::cout << v.size() << " " << bad << " " << shrunk << " " << (reads > 0) << std::endl;
+}
+
+// holds a heap string, and throws when built from a negative value.
+struct Fragile {
+	std::string s;
+
+	explicit Fragile(int v) : s(std::to_string(v) + std::string(40, '.'))
+	{
+		if (v < 0) {
+			throw std::runtime_error("negative");
+		}
+	}
+};
+
+void TestThrowingAppend()
+{
+	std::cout << "Testing an append whose constructor throws..." << std::endl;
+	sjtu::concurrent_vector<Fragile> v;
+	v.emplace_back(1);
+	v.emplace_back(2);
+	try {
+		v.emplace_back(-3);
+	} catch (const std::runtime_error &e) {
+		std::cout << e.what() << std::endl;
+	}
+	v.emplace_back(4);
+	std::cout << v.size() << " " << v.back().s.substr(0, 1) << std::endl;
+	v.clear();
+	v.emplace_back(5);
+	std::cout << v.size() << " " << v[0].s.substr(0, 1) << std::endl;
+}
+
+void TestStability()
+{
+	std::cout << "Testing that elements never move..." << std::endl;
+	sjtu::concurrent_vector<std::string> v;
+	v.push_back("first");
+	std::string *first = &v[0];
+	sjtu::concurrent_vector<std::string>::iterator it = v.begin();
+	for (int i = 1; i < 100000; ++i) {
+		v.emplace_back(std::to_string(i));
+	}
+	std::cout << (first == &v[0]) << " " << *it << " " << v.size() << " " << v.back() << " "
+	          << (v.capacity() >= v.size()) << std::endl;
+	try {
+		v.at(v.size());
+	} catch (const sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	sjtu::concurrent_vector<std::string> c(v);
+	v.clear();
+	std::cout << v.size() << " " << v.empty() << " " << c.size() << " " << c[99999] << std::endl;
+	v.reserve(1000);
+	std::cout << (v.capacity() >= 1000) << " " << v.size() << std::endl;
+	size_t n = 0;
+	for (const std::string &s : c) {
+		n += s.size();
+	}
+	std::cout << n << std::endl;
+}
+
+void TestAllocators()
+{
+	std::cout << "Testing non-propagating allocators..." << std::endl;
+	using A = tagged_allocator<std::string>;
+	sjtu::concurrent_vector<std::string, A> a(A(1)), b(A(2)), c(A(1));
+	for (int i = 0; i < 100; ++i) {
+		a.push_back(std::to_string(i));
+		b.push_back("b" + std::to_string(i));
+	}
+	a = std::move(b);
+	std::cout << a.size() << " " << a[7] << " " << a.get_allocator().tag << " " << b.get_allocator().tag << std::endl;
+	c = a;
+	std::cout << c.size() << " " << c[9] << " " << c.get_allocator().tag << std::endl;
+	b.push_back("x");
+	swap(a, b);
+	std::cout << a.size() << " " << b.size() << " " << a[0] << " " << a.get_allocator().tag << " "
+	          << b.get_allocator().tag << std::endl;
+	sjtu::concurrent_vector<std::string, A> d(std::move(c));
+	std::cout << d.size() << " " << c.size() << " " << d.get_allocator().tag << std::endl;
+}
+
+int main()
+{
+	TestConcurrentAppend();
+	TestConcurrentRead();
+	TestThrowingAppend();
+	TestStability();
+	TestAllocators();
+	return 0;
+}
@@ -0,0 +1,160 @@
+#include "vector.hpp"
+
+#include <array>
+#include <iostream>
+#include <string>
+
+// every check runs at run time; under C++20 the same functions are also evaluated in static_asserts.
+#if __cplusplus >= 202002L
+#define CHECK_CONSTANT(expr) static_assert(expr, #expr)
+#else
+#define CHECK_CONSTANT(expr)
+#endif
+
+SJTU_CONSTEXPR20 long long PushBackSum(int n)
+{
+	sjtu::vector<int> v;
+	for (int i = 0; i < n; ++i) {
+		v.push_back(i * i);
+	}
+	v.emplace_back(-1);
+	long long sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum += v[i];
+	}
+	return sum * 1000 + static_cast<long long>(v.size());
+}
+
+SJTU_CONSTEXPR20 long long InsertErase()
+{
+	sjtu::vector<int> v;
+	for (int i = 1; i <= 5; ++i) {
+		v.push_back(i);
+	}
+	v.insert(v.begin(), 0);
+	v.insert(3, 9);
+	v.insert(v.end(), 2, 7);
+	v.erase(v.begin() + 1);
+	v.erase(v.size() - 1);
+	v.erase(0, 1);
+	v.pop_back();
+	int extra[] = {8, 6};
+	v.insert(v.begin() + 2, extra, extra + 2);
+	long long digits = 0;
+	for (int x : v) {
+		digits = digits * 10 + x;
+	}
+	return digits * 100 + static_cast<long long>(v.size());
+}
+
+SJTU_CONSTEXPR20 long long Iterators()
+{
+	sjtu::vector<int> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i);
+	}
+	sjtu::vector<int>::iterator it = v.begin();
+	it += 3;
+	*it = 30;
+	it = it + 2;
+	it[1] = 60;
+	--it;
+	*it = 40;
+	sjtu::vector<int>::const_iterator cit = v.cbegin() + 9;
+	long long res = *cit;
+	res = res * 100 + (v.end() - v.begin());
+	res = res * 10 + (cit > v.cbegin() + 8) + (v.begin() + 9 == cit) + (v.end() != v.cend());
+	long long backwards = 0;
+	for (sjtu::vector<int>::iterator p = v.end(); p != v.begin();) {
+		--p;
+		backwards = backwards * 10 + *p % 10;
+	}
+	int sum = 0;
+	for (const int &x : v) {
+		sum += x;
+	}
+	return (res * 1000 + sum) * 10000000000LL + backwards;
+}
+
+SJTU_CONSTEXPR20 size_t Strings()
+{
+	sjtu::vector<std::string> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(std::string(i, 'x'));
+	}
+	v.insert(v.begin(), "front");
+	v.erase(v.begin() + 1, v.begin() + 4);
+	sjtu::vector<std::string> w = v;
+	w.resize(3);
+	size_t total = 0;
+	for (const std::string &s : w) {
+		total += s.size();
+	}
+	return total * 100 + v.size();
+}
+
+SJTU_CONSTEXPR20 std::array<int, 8> Table()
+{
+	sjtu::vector<int> v;
+	v.reserve(2);
+	for (int i = 0; i < 8; ++i) {
+		v.insert(v.begin(), i * 3);
+	}
+	std::array<int, 8> res{};
+	for (size_t i = 0; i < v.size(); ++i) {
+		res[i] = v.at(i);
+	}
+	return res;
+}
+
+SJTU_CONSTEXPR20 long long Bools()
+{
+	sjtu::vector<bool> v;
+	for (int i = 0; i < 130; ++i) {
+		v.push_back(i % 3 == 0);
+	}
+	v.insert(v.begin(), true);
+	v.insert(65, false);
+	v.erase(v.begin() + 2);
+	v[1] = true;
+	v[4].flip();
+	long long set = static_cast<long long>(v.count());
+	v.flip();
+	long long first = static_cast<long long>(v.find_first());
+	sjtu::vector<bool> w(v.size(), true);
+	w ^= v;
+	int walked = 0;
+	for (sjtu::vector<bool>::const_iterator it = w.cbegin(); it != w.cend(); ++it) {
+		walked += *it;
+	}
+	return ((set * 1000 + first) * 1000 + walked) * 1000 + static_cast<long long>(v.size());
+}
+
+CHECK_CONSTANT(PushBackSum(0) == -999);
+CHECK_CONSTANT(PushBackSum(100) == 328349101);
+CHECK_CONSTANT(InsertErase() == 298634507);
+CHECK_CONSTANT(Iterators() == 91021629870500210LL);
+CHECK_CONSTANT(Strings() == 1208);
+CHECK_CONSTANT(Table()[0] == 21 && Table()[3] == 12 && Table()[7] == 0);
+CHECK_CONSTANT(Bools() == 46002046131LL);
+
+int main()
+{
+	std::cout << "Testing push_back..." << std::endl;
+	std::cout << PushBackSum(0) << " " << PushBackSum(100) << std::endl;
+	std::cout << "Testing insert and erase..." << std::endl;
+	std::cout << InsertErase() << std::endl;
+	std::cout << "Testing iterators..." << std::endl;
+	std::cout << Iterators() << std::endl;
+	std::cout << "Testing non-trivial elements..." << std::endl;
+	std::cout << Strings() << std::endl;
+	std::cout << "Testing a table copied out of the vector..." << std::endl;
+	std::array<int, 8> table = Table();
+	for (int x : table) {
+		std::cout << x << " ";
+	}
+	std::cout << std::endl;
+	std::cout << "Testing vector<bool>..." << std::endl;
+	std::cout << Bools() << std::endl;
+	return 0;
+}
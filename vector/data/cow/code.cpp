@@ -0,0 +1,114 @@
+#include "cow_vector.hpp"
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+template<class Vector>
+void Print(const Vector &v)
+{
+	std::cout << v.size() << ":";
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << " " << v[i];
+	}
+	std::cout << std::endl;
+}
+
+void TestSharing()
+{
+	std::cout << "Testing shared copies..." << std::endl;
+	sjtu::cow_vector<std::string> a;
+	std::cout << a.use_count() << " " << a.size() << " " << a.empty() << std::endl;
+	for (int i = 0; i < 5; ++i) {
+		a.push_back(std::to_string(i));
+	}
+	const sjtu::cow_vector<std::string> b(a);
+	sjtu::cow_vector<std::string> c;
+	c = b;
+	std::cout << a.use_count() << " " << (a.view().data() == b.view().data()) << " "
+	          << (b.view().data() == c.view().data()) << std::endl;
+	std::cout << b[2] << " " << b.front() << " " << b.back() << " " << a.use_count() << std::endl;
+	c.push_back("5");
+	std::cout << a.use_count() << " " << c.use_count() << " " << (a.view().data() == c.view().data()) << std::endl;
+	Print(b);
+	Print(c);
+	a.erase(0);
+	a.insert(0, "first");
+	std::cout << a.use_count() << " " << b.use_count() << std::endl;
+	Print(a);
+	Print(b);
+	sjtu::cow_vector<std::string> m(std::move(c));
+	std::cout << m.use_count() << " " << c.use_count() << " " << c.size() << std::endl;
+	swap(m, c);
+	std::cout << c.size() << " " << m.size() << std::endl;
+}
+
+void TestUnshareable()
+{
+	std::cout << "Testing mutable references..." << std::endl;
+	sjtu::cow_vector<int> a(4, 7);
+	sjtu::cow_vector<int> b(a);
+	int &first = a[0];
+	std::cout << a.use_count() << " " << b.use_count() << std::endl;
+	sjtu::cow_vector<int> c(a);
+	first = 100;
+	std::cout << a[0] << " " << b[0] << " " << c[0] << " " << a.use_count() << " " << c.use_count() << std::endl;
+	for (int &x : c) {
+		x += 1;
+	}
+	Print(c);
+	a.clear();
+	a.push_back(1);
+	sjtu::cow_vector<int> d(a);
+	std::cout << a.use_count() << " " << d.use_count() << std::endl;
+	try {
+		d.at(5);
+	} catch (const sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	d.pop_back();
+	try {
+		d.pop_back();
+	} catch (const sjtu::container_is_empty &) {
+		std::cout << "container_is_empty" << std::endl;
+	}
+	std::cout << a.size() << " " << d.size() << std::endl;
+}
+
+void TestThreads()
+{
+	std::cout << "Testing copies in several threads..." << std::endl;
+	sjtu::vector<long long> base;
+	for (int i = 0; i < 1000; ++i) {
+		base.push_back(i);
+	}
+	const sjtu::cow_vector<long long> shared(base);
+	std::vector<long long> sums(4, 0);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < 4; ++t) {
+		workers.emplace_back([&shared, &sums, t] {
+			for (int round = 0; round < 20000; ++round) {
+				sjtu::cow_vector<long long> copy(shared);
+				sums[t] += copy.view()[round % 1000];
+				if (round % 1000 == 0) {
+					copy.push_back(t);
+					sums[t] += copy.back();
+				}
+			}
+		});
+	}
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+	std::cout << shared.use_count() << " " << sums[0] << " " << sums[1] << " " << sums[2] << " " << sums[3]
+	          << std::endl;
+}
+
+int main()
+{
+	TestSharing();
+	TestUnshareable();
+	TestThreads();
+	return 0;
+}
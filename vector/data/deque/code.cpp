@@ -0,0 +1,138 @@
+#include "deque.hpp"
+#include "class-matrix.hpp"
+#include "class-bint.hpp"
+
+#include <iostream>
+#include <string>
+#include <utility>
+
+template<class Deque>
+void Print(const Deque &d)
+{
+	std::cout << d.size() << ":";
+	for (size_t i = 0; i < d.size(); ++i) {
+		std::cout << " " << d[i];
+	}
+	std::cout << std::endl;
+}
+
+void TestBothEnds()
+{
+	std::cout << "Testing both ends..." << std::endl;
+	sjtu::deque<int> d;
+	for (int i = 0; i < 5; ++i) {
+		d.push_back(i);
+		d.push_front(-i - 1);
+	}
+	Print(d);
+	d.pop_front();
+	d.pop_back();
+	d.emplace_front(100) += 1;
+	d.emplace_back(200);
+	Print(d);
+	std::cout << d.front() << " " << d.back() << " " << d.at(3) << std::endl;
+	try {
+		d.at(d.size());
+	} catch (const sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	while (!d.empty()) {
+		d.pop_back();
+	}
+	try {
+		d.pop_front();
+	} catch (const sjtu::container_is_empty &) {
+		std::cout << "container_is_empty" << std::endl;
+	}
+	long long sum = 0;
+	for (int i = 0; i < 100000; ++i) {
+		if (i % 3 == 0) {
+			d.push_front(i);
+		} else {
+			d.push_back(i);
+		}
+		if (i % 5 == 0) {
+			d.pop_front();
+		}
+	}
+	for (int x : d) {
+		sum += x;
+	}
+	std::cout << d.size() << " " << d.front() << " " << d.back() << " " << sum << std::endl;
+}
+
+void TestStableReferences()
+{
+	std::cout << "Testing that references stay valid..." << std::endl;
+	sjtu::deque<std::string> d;
+	d.push_back("middle");
+	std::string *middle = &d[0];
+	for (int i = 0; i < 50000; ++i) {
+		d.push_back("b" + std::to_string(i));
+		d.push_front("f" + std::to_string(i));
+	}
+	std::cout << (middle == &d[50000]) << " " << *middle << " " << d.front() << " " << d.back() << std::endl;
+	for (int i = 0; i < 49990; ++i) {
+		d.pop_front();
+		d.pop_back();
+	}
+	std::cout << (middle == &d[10]) << " " << d.size() << " " << d.front() << " " << d.back() << std::endl;
+	sjtu::stable_vector<int> v;
+	v.push_back(1);
+	int *first = &v.front();
+	for (int i = 2; i <= 100000; ++i) {
+		v.push_back(i);
+	}
+	std::cout << (first == &v[0]) << " " << v.size() << " " << v.back() << std::endl;
+}
+
+void TestCopyAndMove()
+{
+	std::cout << "Testing copy, move and swap..." << std::endl;
+	sjtu::deque<std::string> a(3, std::string("a")), b;
+	for (int i = 0; i < 1000; ++i) {
+		b.push_front(std::to_string(i));
+	}
+	sjtu::deque<std::string> c(b);
+	c.pop_front();
+	std::cout << b.size() << " " << b.front() << " " << c.size() << " " << c.front() << std::endl;
+	a = c;
+	c.clear();
+	std::cout << a.size() << " " << a.back() << " " << c.size() << std::endl;
+	sjtu::deque<std::string> m(std::move(a));
+	std::cout << m.size() << " " << a.size() << std::endl;
+	a = std::move(m);
+	swap(a, b);
+	std::cout << a.size() << " " << b.size() << " " << a.front() << " " << b.front() << std::endl;
+	a = a;
+	std::cout << a.size() << " " << a[500] << std::endl;
+}
+
+void TestMatrices()
+{
+	std::cout << "Testing Matrix<Bint> elements..." << std::endl;
+	sjtu::deque<Diamond::Matrix<Util::Bint>> d;
+	for (int i = 1; i <= 200; ++i) {
+		if (i % 2 == 0) {
+			d.push_back(Diamond::Matrix<Util::Bint>(i % 3 + 1, i % 2 + 1, Util::Bint(i * 817)));
+		} else {
+			d.push_front(Diamond::Matrix<Util::Bint>(i % 3 + 1, i % 2 + 1, Util::Bint(i * 817)));
+		}
+	}
+	Diamond::Matrix<Util::Bint> *kept = &d[100];
+	for (int i = 0; i < 60; ++i) {
+		d.pop_back();
+		d.pop_front();
+	}
+	std::cout << d.size() << " " << (kept == &d[40]) << " " << d.front()[0][0] << " " << d.back()[0][0] << " "
+	          << (*kept)[0][0] << std::endl;
+}
+
+int main()
+{
+	TestBothEnds();
+	TestStableReferences();
+	TestCopyAndMove();
+	TestMatrices();
+	return 0;
+}
@@ -0,0 +1,114 @@
+#define SJTU_CONTAINER_STATS
+#include "vector.hpp"
+
+#include <iostream>
+
+// grows by a fixed step of 10 elements and never shrinks.
+struct step_growth {
+	size_t grow(size_t capacity, size_t required) const
+	{
+		return capacity + 10 < required ? required : capacity + 10;
+	}
+
+	size_t shrink(size_t, size_t capacity) const
+	{
+		return capacity;
+	}
+};
+
+template<class Vector>
+void PrintCapacities(const char *name, int n)
+{
+	Vector v;
+	size_t last = v.capacity();
+	std::cout << name << ": " << last;
+	for (int i = 0; i < n; ++i) {
+		v.push_back(i);
+		if (v.capacity() != last) {
+			last = v.capacity();
+			std::cout << " " << last;
+		}
+	}
+	std::cout << std::endl;
+}
+
+void TestPolicies()
+{
+	std::cout << "Testing the capacities chosen by each policy..." << std::endl;
+	PrintCapacities<sjtu::vector<int>>("double", 300);
+	PrintCapacities<sjtu::vector<int, std::allocator<int>, sjtu::one_and_half_growth>>("one and half", 300);
+	PrintCapacities<sjtu::vector<int, std::allocator<int>, step_growth>>("step", 50);
+	sjtu::vector<int> v(100, 1);
+	std::cout << "shrink:";
+	size_t last = v.capacity();
+	while (!v.empty()) {
+		v.pop_back();
+		if (v.capacity() != last) {
+			last = v.capacity();
+			std::cout << " " << v.size() << "/" << last;
+		}
+	}
+	std::cout << std::endl;
+	sjtu::vector<int, std::allocator<int>, sjtu::double_growth_no_shrink> w(100, 1);
+	size_t capacity = w.capacity();
+	while (!w.empty()) {
+		w.pop_back();
+	}
+	std::cout << "no shrink: " << (w.capacity() == capacity) << std::endl;
+}
+
+void TestOscillation()
+{
+	std::cout << "Testing push/pop oscillation at the capacity boundaries..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 64; ++i) {
+		v.push_back(i);
+	}
+	v.reset_stats();
+	for (int i = 0; i < 100000; ++i) {
+		v.push_back(i);
+		v.pop_back();
+	}
+	std::cout << "grow boundary: " << v.size() << " " << v.capacity() << " " << v.stats().reallocations << std::endl;
+	while (v.size() > 33) {
+		v.pop_back();
+	}
+	v.reset_stats();
+	for (int i = 0; i < 100000; ++i) {
+		v.pop_back();
+		v.push_back(i);
+	}
+	std::cout << "shrink boundary: " << v.size() << " " << v.capacity() << " " << v.stats().reallocations << std::endl;
+}
+
+void TestCapacityControl()
+{
+	std::cout << "Testing reserve, resize and shrink_to_fit..." << std::endl;
+	sjtu::vector<int> v;
+	std::cout << v.capacity() << std::endl;
+	v.reserve(100);
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+	v.reserve(10);
+	std::cout << v.capacity() << std::endl;
+	v.resize(150, 7);
+	std::cout << v.size() << " " << v.capacity() << " " << v[149] << std::endl;
+	v.resize(20);
+	std::cout << v.size() << " " << v.capacity() << " " << v[19] << std::endl;
+	v.resize(25);
+	std::cout << v.size() << " " << v[19] << " " << v[24] << std::endl;
+	v.shrink_to_fit();
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+	v.push_back(1);
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+	v.resize(0);
+	v.shrink_to_fit();
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+}
+
+int main()
+{
+	TestPolicies();
+	TestOscillation();
+	TestCapacityControl();
+	return 0;
+}
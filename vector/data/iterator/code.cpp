@@ -0,0 +1,144 @@
+#include "vector.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <type_traits>
+
+typedef sjtu::vector<int>::iterator Iterator;
+typedef sjtu::vector<int>::const_iterator ConstIterator;
+
+static_assert(std::is_same<std::iterator_traits<Iterator>::iterator_category, std::random_access_iterator_tag>::value,
+              "random access");
+static_assert(std::is_same<std::iterator_traits<ConstIterator>::iterator_category,
+                           std::random_access_iterator_tag>::value,
+              "random access");
+static_assert(std::is_same<std::iterator_traits<Iterator>::reference, int &>::value, "mutable");
+static_assert(std::is_same<std::iterator_traits<ConstIterator>::reference, const int &>::value, "read-only");
+static_assert(std::is_same<std::iterator_traits<ConstIterator>::value_type, int>::value, "value_type");
+static_assert(std::is_convertible<Iterator, ConstIterator>::value, "iterator to const_iterator");
+static_assert(!std::is_convertible<ConstIterator, Iterator>::value, "no const_iterator to iterator");
+#if __cplusplus >= 202002L
+static_assert(std::contiguous_iterator<Iterator>, "contiguous");
+static_assert(std::contiguous_iterator<ConstIterator>, "contiguous");
+static_assert(std::sized_sentinel_for<ConstIterator, Iterator>, "mixed distances");
+static_assert(std::totally_ordered_with<Iterator, ConstIterator>, "mixed comparisons");
+#endif
+
+unsigned seed = 20240601;
+
+int Random()
+{
+	seed = seed * 1103515245u + 12345u;
+	return static_cast<int>((seed >> 8) % 1000);
+}
+
+void TestArithmetic()
+{
+	std::cout << "Testing iterator arithmetic..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i * 10);
+	}
+	Iterator it = v.begin();
+	Iterator jt = it + 7;
+	std::cout << *jt << " " << *(3 + it) << " " << *(jt - 2) << " " << jt[-7] << " " << it[9] << std::endl;
+	it += 4;
+	jt -= 1;
+	std::cout << *it << " " << *jt << " " << (jt - it) << " " << (it - jt) << " " << (v.end() - v.begin()) << std::endl;
+	Iterator old = it++;
+	std::cout << *old << " " << *it;
+	old = it--;
+	std::cout << " " << *old << " " << *it << " " << *++it << " " << *--it << std::endl;
+	it[2] = -1;
+	*it += 5;
+	std::cout << v[4] << " " << v[6] << std::endl;
+	std::advance(it, 3);
+	std::cout << *it << " " << std::distance(v.begin(), it) << " " << *std::next(it, 2) << " " << *std::prev(it, 7)
+	          << std::endl;
+	const sjtu::vector<int> &cv = v;
+	ConstIterator cit = cv.end() - 1;
+	cit -= 2;
+	std::cout << *cit << " " << cit[-1] << " " << *(cit + 1) << " " << (cv.end() - cit) << std::endl;
+	sjtu::vector<std::string> s(3, "abc");
+	s.begin()->append("d");
+	std::cout << s.begin()->size() << " " << (s.cbegin() + 1)->size() << std::endl;
+}
+
+void TestComparisons()
+{
+	std::cout << "Testing comparisons between iterator and const_iterator..." << std::endl;
+	sjtu::vector<int> v(10, 1);
+	Iterator it = v.begin() + 3;
+	ConstIterator cit = v.cbegin() + 5;
+	ConstIterator same = it;
+	std::cout << (it == same) << (same == it) << (it != same) << (same != it) << (it == cit) << (cit != it)
+	          << std::endl;
+	std::cout << (it < cit) << (cit < it) << (it > cit) << (cit > it) << (it <= cit) << (cit <= it) << (it >= cit)
+	          << (cit >= it) << std::endl;
+	std::cout << (it <= same) << (same <= it) << (it >= same) << (same >= it) << (it < same) << (same > it)
+	          << std::endl;
+	std::cout << (cit - it) << " " << (it - cit) << " " << (v.end() - v.cbegin()) << " " << (v.cend() - v.begin())
+	          << std::endl;
+	sjtu::vector<int> other(10, 1);
+	try {
+		std::cout << (other.begin() - v.cbegin()) << std::endl;
+	} catch (const sjtu::invalid_iterator &) {
+		std::cout << "invalid_iterator" << std::endl;
+	}
+	try {
+		std::cout << (other.cbegin() - v.begin()) << std::endl;
+	} catch (const sjtu::invalid_iterator &) {
+		std::cout << "invalid_iterator" << std::endl;
+	}
+	Iterator empty_first, empty_last;
+	std::cout << (empty_first == empty_last) << " " << (empty_last - empty_first) << std::endl;
+}
+
+void TestAlgorithms()
+{
+	std::cout << "Testing standard algorithms..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back(Random());
+	}
+	sjtu::vector<int> copy = v;
+	std::sort(v.begin(), v.end());
+	std::cout << std::is_sorted(v.cbegin(), v.cend()) << " " << v.front() << " " << v[500] << " " << v.back()
+	          << " " << std::accumulate(v.cbegin(), v.cend(), 0LL) << " "
+	          << std::accumulate(copy.cbegin(), copy.cend(), 0LL) << std::endl;
+	const sjtu::vector<int> &cv = v;
+	ConstIterator lower = std::lower_bound(cv.begin(), cv.end(), 488);
+	ConstIterator upper = std::upper_bound(cv.begin(), cv.end(), 488);
+	std::cout << (lower - cv.begin()) << " " << (upper - lower) << " " << *lower << " "
+	          << std::binary_search(cv.begin(), cv.end(), 488) << std::endl;
+	Iterator mutable_lower = std::lower_bound(v.begin(), v.end(), 250);
+	std::cout << (mutable_lower - cv.begin()) << " " << (std::lower_bound(v.begin(), v.end(), 10000) == cv.end())
+	          << std::endl;
+	std::sort(v.begin(), v.end(), std::greater<int>());
+	std::reverse_iterator<Iterator> rfirst(v.end()), rlast(v.begin());
+	std::cout << v.front() << " " << v.back() << " " << std::is_sorted(rfirst, rlast) << std::endl;
+	std::reverse(v.begin(), v.end());
+	std::cout << (v.front() <= v.back()) << std::endl;
+	std::nth_element(copy.begin(), copy.begin() + 500, copy.end());
+	std::cout << copy[500] << " " << (copy[500] == v[500]) << std::endl;
+	sjtu::vector<std::string> words;
+	for (int i = 0; i < 50; ++i) {
+		words.push_back(std::to_string(Random()));
+	}
+	std::stable_sort(words.begin(), words.end());
+	std::cout << std::is_sorted(words.begin(), words.end()) << " " << words.front() << " " << words.back() << std::endl;
+	std::reverse_iterator<ConstIterator> rit(cv.end());
+	std::cout << *rit << " " << *(rit + 999) << " " << std::count(cv.begin(), cv.end(), v[0]) << std::endl;
+}
+
+int main()
+{
+	TestArithmetic();
+	TestComparisons();
+	TestAlgorithms();
+	return 0;
+}
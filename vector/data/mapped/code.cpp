@@ -0,0 +1,151 @@
+#include "mapped_vector.hpp"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <csignal>
+#include <cstdio>
+#include <iostream>
+#include <utility>
+
+struct Record {
+	int id;
+	double score;
+};
+
+const char *kPath = "mapped_vector_test.bin";
+
+template<class Vector>
+void Print(const Vector &v)
+{
+	std::cout << v.size() << ":";
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << " " << v[i].id << "/" << v[i].score;
+	}
+	std::cout << std::endl;
+}
+
+void TestCreate()
+{
+	std::cout << "Testing a new file..." << std::endl;
+	sjtu::mapped_vector<Record> v(kPath, sjtu::mapped_vector<Record>::kTruncate);
+	std::cout << v.size() << " " << v.empty() << " " << v.read_only() << std::endl;
+	for (int i = 0; i < 20; ++i) {
+		v.push_back({i, i * 0.5});
+	}
+	v.insert(v.begin(), {-1, -1});
+	v.insert(5, {100, 1.5});
+	v.erase(v.begin() + 10);
+	v.erase(v.size() - 1);
+	v.pop_back();
+	Print(v);
+	std::cout << v.front().id << " " << v.back().id << " " << (v.capacity() >= v.size()) << std::endl;
+	try {
+		v.at(v.size());
+	} catch (const sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	v.flush();
+}
+
+void TestReopen()
+{
+	std::cout << "Testing reopening the file..." << std::endl;
+	{
+		sjtu::mapped_vector<Record> v(kPath);
+		Print(v);
+		v[0].score = 42;
+		v.resize(22, {7, 7});
+		v.shrink_to_fit();
+		std::cout << v.size() << " " << v.capacity() << std::endl;
+	}
+	const sjtu::mapped_vector<Record> v(kPath, sjtu::mapped_vector<Record>::kReadOnly);
+	std::cout << v.size() << " " << v[0].score << " " << v[21].id << " " << v.read_only() << std::endl;
+}
+
+void TestReadOnly()
+{
+	std::cout << "Testing a read-only file..." << std::endl;
+	sjtu::mapped_vector<Record> v(kPath, sjtu::mapped_vector<Record>::kReadOnly);
+	const sjtu::mapped_vector<Record> &cv = v;
+	try {
+		v[1].id = 555;
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "runtime_error " << cv[1].id << std::endl;
+	}
+	try {
+		v.begin();
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "runtime_error" << std::endl;
+	}
+	long long ids = 0;
+	for (const Record &r : cv) {
+		ids += r.id;
+	}
+	std::cout << ids << " " << (cv.data() + cv.size() == cv.end()) << std::endl;
+	// the pages are mapped without write access, so a write past the accessors kills the process.
+	std::cout.flush();
+	pid_t child = fork();
+	if (child == 0) {
+		signal(SIGSEGV, SIG_DFL);
+		signal(SIGBUS, SIG_DFL);
+		const_cast<Record *>(cv.data())[1].id = 555;
+		_exit(0);
+	}
+	int status = 0;
+	waitpid(child, &status, 0);
+	std::cout << (WIFSIGNALED(status) && (WTERMSIG(status) == SIGSEGV || WTERMSIG(status) == SIGBUS)) << std::endl;
+	try {
+		v.push_back({0, 0});
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "runtime_error" << std::endl;
+	}
+	try {
+		v.clear();
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "runtime_error" << std::endl;
+	}
+	v.flush();
+	const sjtu::mapped_vector<Record> w(kPath, sjtu::mapped_vector<Record>::kReadOnly);
+	std::cout << w[1].id << " " << w.size() << std::endl;
+}
+
+void TestMove()
+{
+	std::cout << "Testing move construction and assignment..." << std::endl;
+	sjtu::mapped_vector<Record> v(kPath);
+	sjtu::mapped_vector<Record> w(std::move(v));
+	std::cout << v.size() << " " << v.capacity() << " " << v.empty() << " " << w.size() << std::endl;
+	v.flush();
+	v = std::move(w);
+	std::cout << v.size() << " " << w.size() << std::endl;
+	sjtu::mapped_vector<Record> u(kPath, sjtu::mapped_vector<Record>::kReadOnly);
+	swap(u, v);
+	std::cout << u.read_only() << " " << v.read_only() << " " << u.size() << std::endl;
+}
+
+void TestMismatch()
+{
+	std::cout << "Testing files of another format..." << std::endl;
+	try {
+		sjtu::mapped_vector<long long> v(kPath);
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "runtime_error" << std::endl;
+	}
+	try {
+		sjtu::mapped_vector<Record> v("mapped_vector_missing.bin", sjtu::mapped_vector<Record>::kReadOnly);
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "runtime_error" << std::endl;
+	}
+}
+
+int main()
+{
+	TestCreate();
+	TestReopen();
+	TestReadOnly();
+	TestMove();
+	TestMismatch();
+	std::remove(kPath);
+	return 0;
+}
@@ -0,0 +1,79 @@
+#include "vector.hpp"
+#include "mmap_allocator.hpp"
+
+#include <iostream>
+#include <string>
+
+template<class T>
+using big_vector = sjtu::vector<T, sjtu::mmap_allocator<T>>;
+
+// maps every block of at least one page, so that small tests cross the threshold.
+template<class T>
+using paged_vector = sjtu::vector<T, sjtu::mmap_allocator<T, 4096>>;
+
+void TestGrowth()
+{
+	std::cout << "Testing growth across the mmap threshold..." << std::endl;
+	big_vector<long long> v;
+	const long long n = 3000000;
+	for (long long i = 0; i < n; ++i) {
+		v.push_back(i * 7);
+	}
+	long long sum = 0;
+	for (long long i = 0; i < n; ++i) {
+		sum += v[i];
+	}
+	std::cout << v.size() << " " << v[0] << " " << v[n - 1] << " " << sum << std::endl;
+	v.erase(v.begin() + 100, v.end());
+	v.shrink_to_fit();
+	std::cout << v.size() << " " << v.capacity() << " " << v[99] << std::endl;
+	v.resize(1000000, -1);
+	std::cout << v.size() << " " << v[99] << " " << v[100] << " " << v.back() << std::endl;
+}
+
+void TestPaged()
+{
+	std::cout << "Testing a page-sized threshold..." << std::endl;
+	paged_vector<int> v;
+	size_t last = 0;
+	for (int i = 0; i < 10000; ++i) {
+		v.push_back(i);
+		if (v.capacity() != last) {
+			last = v.capacity();
+			std::cout << last << " ";
+		}
+	}
+	std::cout << std::endl;
+	bool ok = true;
+	for (int i = 0; i < 10000; ++i) {
+		ok = ok && v[i] == i;
+	}
+	std::cout << ok << std::endl;
+	paged_vector<int> c(v);
+	v.insert(v.begin(), 5000, 1);
+	std::cout << c.size() << " " << c[9999] << " " << v.size() << " " << v[4999] << " " << v[5000] << std::endl;
+	while (v.size() > 10) {
+		v.pop_back();
+	}
+	std::cout << v.size() << " " << v.capacity() << " " << v[9] << std::endl;
+}
+
+void TestNotRelocatable()
+{
+	std::cout << "Testing elements that are not trivially relocatable..." << std::endl;
+	paged_vector<std::string> v;
+	for (int i = 0; i < 2000; ++i) {
+		v.push_back(std::to_string(i) + std::string(30, '.'));
+	}
+	std::cout << v.size() << " " << v[1234].substr(0, 6) << " " << v.back().size() << std::endl;
+	v.erase(v.begin(), v.begin() + 1990);
+	std::cout << v.size() << " " << v.front().substr(0, 6) << std::endl;
+}
+
+int main()
+{
+	TestGrowth();
+	TestPaged();
+	TestNotRelocatable();
+	return 0;
+}
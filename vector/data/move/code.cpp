@@ -0,0 +1,162 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <string>
+
+// counts the copies and moves of its objects; the move constructor is noexcept only if NothrowMove.
+template<bool NothrowMove>
+class Counted {
+public:
+	static int copies, moves, alive;
+
+	Counted(int value = 0) : value_(new int(value)) { ++alive; }
+	Counted(const Counted &other) : value_(new int(*other.value_)) { ++copies; ++alive; }
+	Counted(Counted &&other) noexcept(NothrowMove) : value_(other.value_) { other.value_ = nullptr; ++moves; ++alive; }
+	Counted &operator=(const Counted &other)
+	{
+		if (this != &other) {
+			delete value_;
+			value_ = new int(*other.value_);
+			++copies;
+		}
+		return *this;
+	}
+	Counted &operator=(Counted &&other) noexcept(NothrowMove)
+	{
+		std::swap(value_, other.value_);
+		++moves;
+		return *this;
+	}
+	~Counted() { delete value_; --alive; }
+
+	int value() const { return value_ == nullptr ? -1 : *value_; }
+
+	static void Reset() { copies = moves = 0; }
+
+private:
+	int *value_;
+};
+
+template<bool NothrowMove> int Counted<NothrowMove>::copies = 0;
+template<bool NothrowMove> int Counted<NothrowMove>::moves = 0;
+template<bool NothrowMove> int Counted<NothrowMove>::alive = 0;
+
+// an element whose copy throws once the budget runs out.
+class Fragile {
+public:
+	static int budget;
+
+	Fragile(int value = 0) : text_(std::to_string(value)) {}
+	Fragile(const Fragile &other) : text_(other.text_) { Spend(); }
+	Fragile(Fragile &&other) : text_(std::move(other.text_)) {}
+	Fragile &operator=(const Fragile &other)
+	{
+		Spend();
+		text_ = other.text_;
+		return *this;
+	}
+
+	const std::string &text() const { return text_; }
+
+private:
+	static void Spend()
+	{
+		if (budget >= 0 && budget-- == 0) {
+			throw 0;
+		}
+	}
+
+	std::string text_;
+};
+
+int Fragile::budget = -1;
+
+template<class T>
+void Print(const sjtu::vector<T> &v)
+{
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i].value() << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestMoveOnGrowth()
+{
+	std::cout << "Testing that growth moves elements with a noexcept move..." << std::endl;
+	using T = Counted<true>;
+	sjtu::vector<T> v;
+	T::Reset();
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(T(i));
+	}
+	std::cout << "copies " << T::copies << std::endl;
+	for (int i = 0; i < 50; ++i) {
+		v.insert(v.begin() + i, T(-i));
+	}
+	for (int i = 0; i < 30; ++i) {
+		v.erase(v.begin() + i);
+	}
+	v.emplace_back(1000);
+	T t(2000);
+	v.insert(v.begin() + 5, std::move(t));
+	std::cout << "copies " << T::copies << " moved-from " << t.value() << std::endl;
+	std::cout << v.size() << " " << v[0].value() << " " << v[5].value() << " " << v.back().value() << std::endl;
+}
+
+void TestCopyWithoutNoexcept()
+{
+	std::cout << "Testing that growth copies elements whose move may throw..." << std::endl;
+	using T = Counted<false>;
+	sjtu::vector<T> v;
+	for (int i = 0; i < 20; ++i) {
+		v.push_back(T(i));
+	}
+	T::Reset();
+	v.reserve(v.capacity() + 1);
+	std::cout << "copies " << T::copies << " moves " << T::moves << std::endl;
+	Print(v);
+}
+
+void TestStrongGuarantee()
+{
+	std::cout << "Testing throwing copies during growth..." << std::endl;
+	int failures = 0, kept = 0;
+	for (int budget = 0; budget < 60; ++budget) {
+		sjtu::vector<Fragile> v;
+		for (int i = 0; i < 16; ++i) {
+			v.push_back(Fragile(i));
+		}
+		Fragile::budget = budget;
+		try {
+			switch (budget % 4) {
+			case 0:
+				for (int i = 0; i < 20; ++i) {
+					v.push_back(Fragile(i));
+				}
+				break;
+			case 1:
+				v.insert(3, 20, Fragile(7));
+				break;
+			case 2:
+				v.resize(40);
+				break;
+			default:
+				v.reserve(100);
+			}
+		} catch (int) {
+			++failures;
+			kept += v.size() >= 16 && v[15].text() == "15";
+		}
+		Fragile::budget = -1;
+	}
+	std::cout << failures << " " << kept << std::endl;
+}
+
+int main()
+{
+	TestMoveOnGrowth();
+	TestCopyWithoutNoexcept();
+	TestStrongGuarantee();
+	std::cout << "alive " << Counted<true>::alive + Counted<false>::alive << std::endl;
+	return 0;
+}
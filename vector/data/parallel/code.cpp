@@ -0,0 +1,133 @@
+#include "parallel.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+// composition of affine maps x -> a * x + b modulo kMod: associative but not commutative.
+const long long kMod = 1000000007;
+
+struct Affine {
+	long long a, b;
+};
+
+Affine Compose(const Affine &f, const Affine &g)
+{
+	return {g.a * f.a % kMod, (g.a * f.b + g.b) % kMod};
+}
+
+void TestAlgorithms(size_t threads)
+{
+	std::cout << "Testing the algorithms on " << threads << " threads..." << std::endl;
+	sjtu::par::thread_pool pool(threads);
+	const size_t n = 1000003;
+	sjtu::vector<long long> v(n);
+	sjtu::par::transform(v.begin(), v.end(), v.begin(), [](long long) { return 0LL; }, pool);
+	for (size_t i = 0; i < n; ++i) {
+		v[i] = (long long)(i * 2654435761u % 1000);
+	}
+	sjtu::vector<long long> sq(n);
+	sjtu::par::transform(v.begin(), v.end(), sq.begin(), [](long long x) { return x * x; }, pool);
+	std::cout << sjtu::par::reduce(sq.begin(), sq.end(), 0LL, std::plus<>(), pool) << std::endl;
+	sjtu::par::for_each(v.begin(), v.end(), [](long long &x) { x += 1; }, pool);
+	std::cout << sjtu::par::reduce(v.begin(), v.end(), 0LL, std::plus<>(), pool) << std::endl;
+	std::cout << sjtu::par::count_if(v.begin(), v.end(), [](long long x) { return x % 7 == 0; }, pool) << std::endl;
+	sjtu::vector<long long> scan(n);
+	sjtu::par::inclusive_scan(v.begin(), v.end(), scan.begin(), std::plus<>(), pool);
+	long long acc = 0;
+	bool ok = true;
+	for (size_t i = 0; i < n; ++i) {
+		acc += v[i];
+		ok = ok && scan[i] == acc;
+	}
+	std::cout << ok << " " << scan[n - 1] << std::endl;
+	sjtu::vector<Affine> maps(n);
+	for (size_t i = 0; i < n; ++i) {
+		maps[i] = {(long long)(i % 97 + 2), (long long)(i % 13)};
+	}
+	Affine all = sjtu::par::reduce(maps.begin(), maps.end(), Affine{1, 0}, Compose, pool);
+	std::cout << all.a << " " << all.b << std::endl;
+	sjtu::vector<Affine> prefix(n);
+	sjtu::par::inclusive_scan(maps.begin(), maps.end(), prefix.begin(), Compose, pool);
+	std::cout << (prefix[n - 1].a == all.a && prefix[n - 1].b == all.b) << " " << prefix[500000].b << std::endl;
+	sjtu::vector<long long>::iterator it =
+		sjtu::par::find_if(v.begin(), v.end(), [](long long x) { return x == 1000; }, pool);
+	std::cout << it - v.begin() << std::endl;
+	it = sjtu::par::find_if(v.begin(), v.end(), [](long long x) { return x > 1000; }, pool);
+	std::cout << (it == v.end()) << std::endl;
+}
+
+void TestBool(size_t threads)
+{
+	std::cout << "Testing bool reduce and scan on " << threads << " threads..." << std::endl;
+	sjtu::par::thread_pool pool(threads);
+	const size_t n = 1000003;
+	sjtu::vector<bool> flags;
+	for (size_t i = 0; i < n; ++i) {
+		flags.push_back(i * 2654435761u % 1000 < 3);
+	}
+	auto parity = [](bool a, bool b) { return a != b; };
+	bool serial = false;
+	for (size_t i = 0; i < n; ++i) {
+		serial = serial != flags[i];
+	}
+	std::cout << sjtu::par::reduce(flags.begin(), flags.end(), false, parity, pool) << " " << serial << " "
+	          << sjtu::par::reduce(flags.begin(), flags.end(), false, std::logical_or<>(), pool) << " "
+	          << sjtu::par::reduce(flags.begin(), flags.end(), true, std::logical_and<>(), pool) << std::endl;
+	sjtu::vector<int> scan(n);
+	sjtu::par::inclusive_scan(flags.begin(), flags.end(), scan.begin(), parity, pool);
+	bool acc = false, ok = true;
+	size_t ones = 0;
+	for (size_t i = 0; i < n; ++i) {
+		acc = acc != flags[i];
+		ok = ok && scan[i] == acc;
+		ones += scan[i];
+	}
+	std::cout << ok << " " << ones << std::endl;
+}
+
+void TestEdgeCases()
+{
+	std::cout << "Testing empty ranges, exceptions and nested jobs..." << std::endl;
+	sjtu::par::thread_pool pool(4);
+	sjtu::vector<int> empty;
+	std::cout << sjtu::par::reduce(empty.begin(), empty.end(), 5, std::plus<>(), pool) << " "
+	          << sjtu::par::count_if(empty.begin(), empty.end(), [](int) { return true; }, pool) << " "
+	          << (sjtu::par::find_if(empty.begin(), empty.end(), [](int) { return true; }, pool) == empty.end())
+	          << std::endl;
+	sjtu::vector<int> v(100000, 1);
+	try {
+		sjtu::par::for_each(v.begin(), v.end(), [](int &x) {
+			if (x == 1) {
+				throw std::runtime_error("task failed");
+			}
+		}, pool);
+	} catch (const std::runtime_error &e) {
+		std::cout << e.what() << std::endl;
+	}
+	std::atomic<long long> total(0);
+	pool.run(8, [&](size_t i) {
+		pool.run(1000, [&](size_t j) { total += i * 1000 + j; });
+	});
+	std::cout << total << std::endl;
+	for (int round = 0; round < 200; ++round) {
+		std::atomic<int> count(0);
+		pool.run(16, [&](size_t) { ++count; });
+		if (count != 16) {
+			std::cout << "lost tasks" << std::endl;
+		}
+	}
+	std::cout << pool.size() << std::endl;
+}
+
+int main()
+{
+	TestAlgorithms(1);
+	TestAlgorithms(2);
+	TestAlgorithms(4);
+	TestBool(1);
+	TestBool(4);
+	TestEdgeCases();
+	return 0;
+}
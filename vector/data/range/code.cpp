@@ -0,0 +1,182 @@
+#define SJTU_CONTAINER_STATS
+#include "vector.hpp"
+
+#include <cstddef>
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+// an allocator with no default constructor that counts its allocations in a counter it is given.
+template<class T>
+struct CountingAllocator {
+	typedef T value_type;
+
+	size_t *count;
+
+	explicit CountingAllocator(size_t *count) : count(count) {}
+
+	template<class U>
+	CountingAllocator(const CountingAllocator<U> &other) : count(other.count) {}
+
+	T *allocate(size_t n)
+	{
+		++*count;
+		return std::allocator<T>().allocate(n);
+	}
+
+	void deallocate(T *p, size_t n)
+	{
+		std::allocator<T>().deallocate(p, n);
+	}
+
+	bool operator==(const CountingAllocator &other) const { return count == other.count; }
+
+	bool operator!=(const CountingAllocator &other) const { return count != other.count; }
+};
+
+template<class T>
+void Print(const sjtu::vector<T> &v)
+{
+	std::cout << v.size() << ":";
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << " " << v[i];
+	}
+	std::cout << std::endl;
+}
+
+void TestConstructors()
+{
+	std::cout << "Testing range and fill constructors..." << std::endl;
+	int a[] = {5, 3, 8, 1, 9, 2};
+	sjtu::vector<int> v(a, a + 6);
+	Print(v);
+	std::list<std::string> l = {"alpha", "beta", "gamma"};
+	sjtu::vector<std::string> s(l.begin(), l.end());
+	Print(s);
+	sjtu::vector<std::string> f(4, std::string("ab"));
+	Print(f);
+	std::istringstream in("10 20 30 40 50");
+	sjtu::vector<int> w{std::istream_iterator<int>(in), std::istream_iterator<int>()};
+	Print(w);
+	sjtu::vector<int> z(5);
+	Print(z);
+}
+
+void TestInsert()
+{
+	std::cout << "Testing range and fill insertion..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i);
+	}
+	int a[] = {100, 101, 102};
+	v.insert(v.begin() + 3, a, a + 3);
+	Print(v);
+	v.insert(0, 2, -1);
+	v.insert(v.size(), 2, -2);
+	Print(v);
+	std::list<int> l = {7, 7, 7};
+	sjtu::vector<int>::iterator it = v.insert(v.begin() + 5, l.begin(), l.end());
+	std::cout << it - v.begin() << " " << *it << std::endl;
+	std::istringstream in("1000 2000");
+	v.insert(1, std::istream_iterator<int>(in), std::istream_iterator<int>());
+	Print(v);
+	it = v.insert(v.begin() + 4, a, a);
+	std::cout << it - v.begin() << " " << v.size() << std::endl;
+	sjtu::vector<std::string> s(3, std::string("x"));
+	s.insert(1, 3, std::string("y"));
+	std::string t[] = {"p", "q"};
+	s.insert(s.end(), t, t + 2);
+	Print(s);
+	try {
+		v.insert(v.size() + 1, 1, 0);
+	} catch (const sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+}
+
+void TestErase()
+{
+	std::cout << "Testing range erasure..." << std::endl;
+	sjtu::vector<std::string> v;
+	for (int i = 0; i < 12; ++i) {
+		v.push_back(std::to_string(i));
+	}
+	sjtu::vector<std::string>::iterator it = v.erase(v.begin() + 2, v.begin() + 5);
+	std::cout << *it << std::endl;
+	v.erase(v.size() - 2, v.size());
+	v.erase(0, 0);
+	Print(v);
+	v.erase(v.begin(), v.end());
+	std::cout << v.size() << " " << v.empty() << std::endl;
+	try {
+		v.erase(1, 0);
+	} catch (const sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+}
+
+void TestAssign()
+{
+	std::cout << "Testing assign..." << std::endl;
+	sjtu::vector<int> v(100, 1);
+	size_t capacity = v.capacity();
+	int a[] = {4, 5, 6};
+	v.assign(a, a + 3);
+	Print(v);
+	v.assign(50, 9);
+	std::cout << v.size() << " " << v[49] << " " << (v.capacity() == capacity) << std::endl;
+	std::istringstream in("3 1 4 1 5");
+	v.assign(std::istream_iterator<int>(in), std::istream_iterator<int>());
+	Print(v);
+}
+
+void TestSingleShift()
+{
+	std::cout << "Testing that a splice reallocates at most once..." << std::endl;
+	sjtu::vector<int> v(1000, 0), block(300, 1);
+	v.reset_stats();
+	v.insert(500, block.begin(), block.end());
+	std::cout << v.size() << " " << v.stats().reallocations << " " << v[499] << v[500] << v[799] << v[800]
+	          << std::endl;
+	v.reserve(2000);
+	v.reset_stats();
+	v.insert(100, block.begin(), block.end());
+	// the 1200 elements of the tail move once; the block itself is constructed, not copied.
+	std::cout << v.stats().reallocations << " " << v.stats().bytes_copied / sizeof(int) << std::endl;
+	v.reset_stats();
+	v.erase(100, 400);
+	std::cout << v.size() << " " << v.stats().bytes_copied / sizeof(int) << std::endl;
+}
+
+void TestSinglePassAllocator()
+{
+	std::cout << "Testing single-pass insert with a stateful allocator..." << std::endl;
+	size_t count = 0;
+	CountingAllocator<int> alloc(&count);
+	sjtu::vector<int, CountingAllocator<int>> v(alloc);
+	v.push_back(1);
+	v.push_back(9);
+	size_t before = count;
+	std::istringstream in("2 3 4 5 6 7 8");
+	v.insert(1, std::istream_iterator<int>(in), std::istream_iterator<int>());
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+	std::cout << (count > before) << " " << (v.get_allocator() == alloc) << std::endl;
+}
+
+int main()
+{
+	TestConstructors();
+	TestInsert();
+	TestErase();
+	TestAssign();
+	TestSingleShift();
+	TestSinglePassAllocator();
+	return 0;
+}
@@ -0,0 +1,105 @@
+#include "vector.hpp"
+
+#include <iostream>
+
+// owns its value through a pointer and is marked trivially relocatable below, so vector may move it bytewise.
+class Handle {
+public:
+	static int moves, alive;
+
+	Handle(int value = 0) : value_(new int(value)) { ++alive; }
+	Handle(const Handle &other) : value_(new int(*other.value_)) { ++alive; }
+	Handle(Handle &&other) noexcept : value_(other.value_) { other.value_ = nullptr; ++moves; ++alive; }
+	Handle &operator=(const Handle &other)
+	{
+		*value_ = *other.value_;
+		return *this;
+	}
+	~Handle() { delete value_; --alive; }
+
+	int value() const { return *value_; }
+
+private:
+	int *value_;
+};
+
+int Handle::moves = 0;
+int Handle::alive = 0;
+
+namespace sjtu {
+template<>
+struct is_trivially_relocatable<Handle> : std::true_type {};
+}
+
+struct Point {
+	double x, y;
+};
+
+void TestTraits()
+{
+	std::cout << "Testing the relocation traits..." << std::endl;
+	std::cout << sjtu::is_trivially_relocatable<int>::value << sjtu::is_trivially_relocatable<double>::value
+	          << sjtu::is_trivially_relocatable<Point>::value << sjtu::is_trivially_relocatable<Handle>::value
+	          << sjtu::is_trivially_relocatable<sjtu::vector<int>>::value << std::endl;
+}
+
+void TestTrivial()
+{
+	std::cout << "Testing trivially copyable elements..." << std::endl;
+	sjtu::vector<long long> v;
+	for (int i = 0; i < 1000; ++i) {
+		v.insert(v.begin(), (long long)i * i);
+	}
+	for (int i = 0; i < 500; ++i) {
+		v.erase(v.begin() + i);
+	}
+	long long sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum += v[i];
+	}
+	std::cout << v.size() << " " << v.front() << " " << v.back() << " " << sum << std::endl;
+	sjtu::vector<Point> p;
+	for (int i = 0; i < 100; ++i) {
+		p.push_back({i * 0.5, -i * 0.25});
+	}
+	sjtu::vector<Point> q(p);
+	q.insert(q.begin() + 50, Point{1e9, 1e9});
+	q.erase(q.begin());
+	std::cout << q.size() << " " << q[0].x << " " << q[49].x << " " << q.back().y << std::endl;
+}
+
+void TestRelocatable()
+{
+	std::cout << "Testing a type marked trivially relocatable..." << std::endl;
+	{
+		sjtu::vector<Handle> v;
+		for (int i = 0; i < 200; ++i) {
+			v.emplace_back(i);
+		}
+		for (int i = 0; i < 100; ++i) {
+			v.insert(v.begin(), Handle(-i));
+		}
+		// neither the reallocation nor the shifts call the move constructor.
+		Handle::moves = 0;
+		v.reserve(1000);
+		for (int i = 0; i < 150; ++i) {
+			v.erase(v.begin() + 10);
+		}
+		std::cout << "moves " << Handle::moves << std::endl;
+		std::cout << v.size() << " " << v[0].value() << " " << v[9].value() << " " << v[10].value() << " "
+		          << v.back().value() << std::endl;
+		sjtu::vector<Handle> w = v;
+		v.clear();
+		v.shrink_to_fit();
+		std::cout << w.size() << " " << w[100].value() << " " << Handle::alive << std::endl;
+	}
+	std::cout << "alive " << Handle::alive << std::endl;
+}
+
+int main()
+{
+	TestTraits();
+	TestTrivial();
+	TestRelocatable();
+	return 0;
+}
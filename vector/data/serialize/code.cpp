@@ -0,0 +1,212 @@
+#include "vector.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+struct Point {
+	int x;
+	double y;
+};
+
+struct Student {
+	std::string name;
+	int score;
+};
+
+namespace sjtu {
+
+template<>
+struct serializer<Student> {
+	template<class Writer>
+	static void save(Writer &out, const Student &value)
+	{
+		serializer<std::string>::save(out, value.name);
+		int32_t score = value.score;
+		out.write(&score, sizeof(score));
+	}
+
+	template<class Reader>
+	static Student load(Reader &in)
+	{
+		Student res;
+		res.name = serializer<std::string>::load(in);
+		int32_t score;
+		in.read(&score, sizeof(score));
+		res.score = score;
+		return res;
+	}
+};
+
+}  // namespace sjtu
+
+template<class T>
+std::string Save(const sjtu::vector<T> &v)
+{
+	std::ostringstream os;
+	v.save(os);
+	return os.str();
+}
+
+template<class T>
+void Load(sjtu::vector<T> &v, const std::string &bytes)
+{
+	std::istringstream is(bytes);
+	try {
+		v.load(is);
+		std::cout << "loaded " << v.size() << std::endl;
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "runtime_error " << v.size() << " " << v.empty() << std::endl;
+	}
+}
+
+void TestTrivial()
+{
+	std::cout << "Testing a trivially copyable type..." << std::endl;
+	sjtu::vector<Point> v;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back({i, i * 0.25});
+	}
+	std::string bytes = Save(v);
+	std::cout << bytes.size() << " " << bytes.substr(0, 4) << std::endl;
+	sjtu::vector<Point> w;
+	w.push_back({-1, -1});
+	Load(w, bytes);
+	bool same = (w.size() == v.size());
+	for (size_t i = 0; same && i < v.size(); ++i) {
+		same = (w[i].x == v[i].x && w[i].y == v[i].y);
+	}
+	std::cout << same << " " << w.capacity() << " " << w[99].x << " " << w[99].y << std::endl;
+}
+
+void TestFile()
+{
+	std::cout << "Testing a FILE stream..." << std::endl;
+	sjtu::vector<double> v;
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back(i / 8.0);
+	}
+	std::FILE *fp = std::tmpfile();
+	v.save(fp);
+	std::cout << std::ftell(fp) << std::endl;
+	std::rewind(fp);
+	sjtu::vector<double> w;
+	w.load(fp);
+	double sum = 0;
+	for (size_t i = 0; i < w.size(); ++i) {
+		sum += w[i];
+	}
+	std::cout << w.size() << " " << sum << std::endl;
+	try {
+		w.load(fp);
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "runtime_error " << w.size() << std::endl;
+	}
+	std::fclose(fp);
+}
+
+void TestNonTrivial()
+{
+	std::cout << "Testing non-trivial types..." << std::endl;
+	sjtu::vector<std::string> v;
+	for (int i = 0; i < 20; ++i) {
+		v.push_back(std::string(i, 'a' + i));
+	}
+	v.push_back("");
+	v.push_back(std::string("with\0nul", 8));
+	std::string bytes = Save(v);
+	std::cout << bytes.size() << std::endl;
+	sjtu::vector<std::string> w;
+	Load(w, bytes);
+	bool same = (w.size() == v.size());
+	for (size_t i = 0; same && i < v.size(); ++i) {
+		same = (w[i] == v[i]);
+	}
+	std::cout << same << " " << w[5] << " " << w[20].size() << " " << w[21].size() << std::endl;
+
+	sjtu::vector<Student> s;
+	s.push_back({"alice", 90});
+	s.push_back({"bob", -3});
+	s.push_back({"carol", 100});
+	sjtu::vector<Student> t;
+	Load(t, Save(s));
+	for (size_t i = 0; i < t.size(); ++i) {
+		std::cout << t[i].name << "/" << t[i].score << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestEmpty()
+{
+	std::cout << "Testing empty vectors..." << std::endl;
+	sjtu::vector<int> v;
+	std::string bytes = Save(v);
+	std::cout << bytes.size() << std::endl;
+	sjtu::vector<int> w(5, 1);
+	Load(w, bytes);
+	std::cout << w.empty() << std::endl;
+	w.push_back(3);
+	std::cout << w.size() << " " << w[0] << std::endl;
+	sjtu::vector<std::string> s;
+	sjtu::vector<std::string> t(3, "x");
+	Load(t, Save(s));
+	std::cout << t.empty() << std::endl;
+}
+
+void TestCorrupted()
+{
+	std::cout << "Testing truncated and corrupted streams..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i);
+	}
+	std::string bytes = Save(v);
+	sjtu::vector<int> w(4, 4);
+	Load(w, "");
+	w.assign(4, 4);
+	Load(w, bytes.substr(0, 10));
+	w.assign(4, 4);
+	Load(w, bytes.substr(0, bytes.size() - 1));
+	std::string bad = bytes;
+	bad[0] = 'X';
+	Load(w, bad);
+	sjtu::vector<double> d;
+	Load(d, bytes);
+	sjtu::vector<std::string> s;
+	Load(s, bytes);
+	bad = bytes;
+	uint64_t count = 11;
+	std::memcpy(&bad[8], &count, sizeof(count));
+	Load(w, bad);
+	count = UINT64_MAX / 2;
+	std::memcpy(&bad[8], &count, sizeof(count));
+	Load(w, bad);
+	Load(w, bytes);
+	std::cout << w[9] << std::endl;
+
+	sjtu::vector<std::string> names;
+	names.push_back("first");
+	names.push_back("second");
+	std::string text = Save(names);
+	Load(s, text.substr(0, text.size() - 3));
+	Load(s, text.substr(0, 16 + 8 + 5 + 4));
+	bad = text;
+	uint64_t length = 1000;
+	std::memcpy(&bad[16 + 8 + 5], &length, sizeof(length));
+	Load(s, bad);
+	Load(s, text);
+	std::cout << s[0] << " " << s[1] << std::endl;
+}
+
+int main()
+{
+	TestTrivial();
+	TestFile();
+	TestNonTrivial();
+	TestEmpty();
+	TestCorrupted();
+	return 0;
+}
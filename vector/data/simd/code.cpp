@@ -0,0 +1,98 @@
+#include "simd.hpp"
+
+#include <iostream>
+
+unsigned long long seed = 998244353;
+
+int Random(int n)
+{
+	seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+	return (int)((seed >> 33) % n);
+}
+
+// compares every kernel with a plain loop on all lengths up to 100 and every misalignment, plus one long array.
+// the values are small integers, so that floating-point sums are exact in any order.
+template<class T>
+int CheckKernels()
+{
+	int failures = 0;
+	sjtu::vector<T> a(10100), b(10100);
+	for (size_t i = 0; i < a.size(); ++i) {
+		a[i] = (T)(Random(201) - 100);
+		b[i] = (T)(Random(21) - 10);
+	}
+	for (size_t n = 0; n <= 10007; n = (n < 100 ? n + 1 : 10007 + (n == 10007))) {
+		for (size_t offset = 0; offset < 8; ++offset) {
+			const T *x = a.data() + offset, *y = b.data() + offset;
+			T target = n > 0 ? x[n - 1] : (T)0;
+			size_t find = n, count = 0, min = 0, max = 0;
+			sjtu::simd::sum_type<T> sum = 0, dot = 0;
+			for (size_t i = 0; i < n; ++i) {
+				if (x[i] == target) {
+					find = find == n ? i : find;
+					++count;
+				}
+				min = x[i] < x[min] ? i : min;
+				max = x[i] > x[max] ? i : max;
+				sum += x[i];
+				dot += (sjtu::simd::sum_type<T>)x[i] * y[i];
+			}
+			failures += sjtu::simd::find(x, n, target) != find;
+			failures += sjtu::simd::find(x, n, (T)1000) != n;
+			failures += sjtu::simd::count(x, n, target) != count;
+			failures += sjtu::simd::min_element(x, n) != min;
+			failures += sjtu::simd::max_element(x, n) != max;
+			failures += sjtu::simd::sum(x, n) != sum;
+			failures += sjtu::simd::dot(x, y, n) != dot;
+			sjtu::vector<T> f(n + 2, (T)7);
+			sjtu::simd::fill(f.data() + 1, n, (T)-3);
+			bool filled = f[0] == 7 && f[n + 1] == 7;
+			for (size_t i = 1; i <= n; ++i) {
+				filled = filled && f[i] == -3;
+			}
+			failures += !filled;
+		}
+	}
+	return failures;
+}
+
+void TestIsa(sjtu::simd::isa limit)
+{
+	sjtu::simd::set_isa_limit(limit);
+	std::cout << CheckKernels<int>() << " " << CheckKernels<long long>() << " " << CheckKernels<float>() << " "
+	          << CheckKernels<double>() << std::endl;
+}
+
+void TestVectorOverloads()
+{
+	std::cout << "Testing the vector overloads..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back((i * 37) % 1001 - 500);
+	}
+	std::cout << sjtu::simd::find(v, 0) << " " << sjtu::simd::find(v, 999) << " " << sjtu::simd::count(v, -500)
+	          << " " << v[sjtu::simd::min_element(v)] << " " << v[sjtu::simd::max_element(v)] << " "
+	          << sjtu::simd::sum(v) << " " << sjtu::simd::dot(v, v) << std::endl;
+	sjtu::vector<int> empty;
+	std::cout << sjtu::simd::find(empty, 1) << " " << sjtu::simd::min_element(empty) << " "
+	          << sjtu::simd::sum(empty) << std::endl;
+	sjtu::vector<double> d(1000, 0.5);
+	sjtu::simd::fill(d, 0.25);
+	std::cout << sjtu::simd::sum(d) << " " << sjtu::simd::dot(d, d) << std::endl;
+	try {
+		sjtu::simd::dot(v, empty);
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "runtime_error" << std::endl;
+	}
+}
+
+int main()
+{
+	std::cout << "Testing every kernel against a scalar loop at each instruction set..." << std::endl;
+	TestIsa(sjtu::simd::isa::kBaseline);
+	TestIsa(sjtu::simd::isa::kSse42);
+	TestIsa(sjtu::simd::isa::kAvx2);
+	TestIsa(sjtu::simd::isa::kAvx512);
+	TestVectorOverloads();
+	return 0;
+}
@@ -0,0 +1,153 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+size_t allocations = 0, live_blocks = 0;
+
+// std::allocator counting its calls.
+template<class T>
+class counting_allocator : public std::allocator<T> {
+public:
+	template<class U>
+	struct rebind {
+		using other = counting_allocator<U>;
+	};
+
+	counting_allocator() = default;
+
+	template<class U>
+	counting_allocator(const counting_allocator<U> &) {}
+
+	T *allocate(size_t n)
+	{
+		++allocations;
+		++live_blocks;
+		return std::allocator<T>::allocate(n);
+	}
+
+	void deallocate(T *p, size_t n)
+	{
+		--live_blocks;
+		std::allocator<T>::deallocate(p, n);
+	}
+};
+
+template<class T>
+using tracked_vector = sjtu::vector<T, counting_allocator<T>>;
+
+template<class T, size_t N>
+using tracked_small_vector = sjtu::small_vector<T, N, counting_allocator<T>>;
+
+size_t Allocations()
+{
+	return allocations;
+}
+
+template<class Vector>
+void Print(const Vector &v)
+{
+	std::cout << v.size() << ":";
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << " " << v[i];
+	}
+	std::cout << std::endl;
+}
+
+void TestDefaultConstruction()
+{
+	std::cout << "Testing that empty vectors do not allocate..." << std::endl;
+	size_t before = Allocations();
+	for (int i = 0; i < 1000; ++i) {
+		tracked_vector<int> v;
+		tracked_vector<std::string> s;
+		tracked_vector<int> c(v);
+		tracked_vector<int> m(std::move(v));
+		v.clear();
+	}
+	std::cout << "allocations " << Allocations() - before << std::endl;
+	tracked_vector<int> v;
+	std::cout << v.size() << " " << v.capacity() << " " << v.empty() << std::endl;
+	v.push_back(1);
+	std::cout << "allocations " << Allocations() - before << " " << v.capacity() << std::endl;
+}
+
+void TestInline()
+{
+	std::cout << "Testing small_vector within its inline capacity..." << std::endl;
+	size_t before = Allocations();
+	for (int i = 0; i < 1000; ++i) {
+		tracked_small_vector<std::string, 4> v;
+		for (int j = 0; j < 3; ++j) {
+			v.push_back(std::string(1, 'a' + j));
+		}
+		v.insert(v.begin(), v.back());
+		v.erase(v.begin() + 3);
+		v.push_back("d");
+		tracked_small_vector<std::string, 4> c(v), m(std::move(c));
+		m.swap(v);
+	}
+	std::cout << "allocations " << Allocations() - before << std::endl;
+	tracked_small_vector<int, 4> v;
+	std::cout << v.capacity() << std::endl;
+	for (int i = 0; i < 4; ++i) {
+		v.push_back(i * i);
+	}
+	Print(v);
+	std::cout << "allocations " << Allocations() - before << " " << v.capacity() << std::endl;
+}
+
+void TestSpill()
+{
+	std::cout << "Testing small_vector beyond its inline capacity..." << std::endl;
+	size_t before = Allocations();
+	tracked_small_vector<std::string, 3> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(std::to_string(i * 11));
+		std::cout << v.capacity() << " ";
+	}
+	std::cout << std::endl << "allocations " << Allocations() - before << std::endl;
+	Print(v);
+	tracked_small_vector<std::string, 3> w;
+	w.push_back("w");
+	v.swap(w);
+	Print(v);
+	Print(w);
+	tracked_small_vector<std::string, 3> m(std::move(w));
+	std::cout << m.size() << " " << w.size() << " " << m[9] << std::endl;
+	while (m.size() > 2) {
+		m.pop_back();
+	}
+	m.shrink_to_fit();
+	Print(m);
+	std::cout << m.capacity() << " " << live_blocks << std::endl;
+}
+
+void TestStatic()
+{
+	std::cout << "Testing static_vector..." << std::endl;
+	sjtu::static_vector<int, 5> v;
+	for (int i = 0; i < 5; ++i) {
+		v.push_back(i + 1);
+	}
+	try {
+		v.push_back(6);
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "runtime_error" << std::endl;
+	}
+	Print(v);
+	v.erase(v.begin());
+	v.insert(v.begin() + 2, 10);
+	Print(v);
+}
+
+int main()
+{
+	TestDefaultConstruction();
+	TestInline();
+	TestSpill();
+	TestStatic();
+	std::cout << "live blocks " << live_blocks << std::endl;
+	return 0;
+}
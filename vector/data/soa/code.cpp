@@ -0,0 +1,146 @@
+#include "soa_vector.hpp"
+
+#include <iostream>
+#include <string>
+#include <tuple>
+
+// a field whose copy throws once the budget runs out.
+class Fragile {
+public:
+	static int budget;
+
+	Fragile(int value = 0) : value_(value) {}
+	Fragile(const Fragile &other) : value_(other.value_) { Spend(); }
+	Fragile &operator=(const Fragile &other)
+	{
+		Spend();
+		value_ = other.value_;
+		return *this;
+	}
+
+	int value() const { return value_; }
+
+private:
+	static void Spend()
+	{
+		if (budget >= 0 && budget-- == 0) {
+			throw 0;
+		}
+	}
+
+	int value_;
+};
+
+int Fragile::budget = -1;
+
+using Table = sjtu::soa_vector<int, double, std::string>;
+
+void Print(const Table &t)
+{
+	std::cout << t.size() << ":";
+	for (Table::const_iterator it = t.begin(); it != t.end(); ++it) {
+		std::cout << " (" << (*it).get<0>() << "," << (*it).get<1>() << "," << (*it).get<2>() << ")";
+	}
+	std::cout << std::endl;
+}
+
+void TestRows()
+{
+	std::cout << "Testing rows..." << std::endl;
+	Table t;
+	for (int i = 0; i < 6; ++i) {
+		t.push_back(i, i * 1.5, std::string(i, 'x'));
+	}
+	t.push_back(std::make_tuple(6, 9.0, std::string("six")));
+	Print(t);
+	t[0].get<2>() = "zero";
+	t[1] = std::make_tuple(-1, -1.5, std::string("minus"));
+	t[2] = t[3];
+	t.insert(4, std::make_tuple(40, 4.0, std::string("forty")));
+	t.erase(t.begin() + 5);
+	t.pop_back();
+	Print(t);
+	std::tuple<int, double, std::string> row = t.back();
+	std::cout << std::get<0>(row) << " " << std::get<2>(row) << " " << t.front().get<2>() << std::endl;
+	try {
+		t.at(t.size());
+	} catch (const sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	try {
+		t.erase(t.size());
+	} catch (const sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	t.clear();
+	try {
+		t.pop_back();
+	} catch (const sjtu::container_is_empty &) {
+		std::cout << "container_is_empty" << std::endl;
+	}
+	std::cout << t.size() << " " << t.empty() << std::endl;
+}
+
+void TestColumns()
+{
+	std::cout << "Testing column scans..." << std::endl;
+	sjtu::soa_vector<int, double, char> t;
+	t.reserve(100000);
+	for (int i = 0; i < 100000; ++i) {
+		t.push_back(i % 1000, i * 0.25, (char)('a' + i % 26));
+	}
+	auto ids = t.column<0>();
+	auto weights = t.column<1>();
+	long long id_sum = 0;
+	double weight_sum = 0;
+	for (size_t i = 0; i < ids.size(); ++i) {
+		id_sum += ids[i];
+		weight_sum += weights[i];
+	}
+	std::cout << ids.size() << " " << id_sum << " " << (long long)weight_sum << std::endl;
+	auto letters = t.column<2>();
+	for (size_t i = 0; i < letters.size(); ++i) {
+		letters[i] = letters[i] - 'a' + 'A';
+	}
+	std::cout << t[27].get<2>() << " " << t[99999].get<2>() << std::endl;
+	for (int i = 0; i < 50000; ++i) {
+		t.erase(0);
+	}
+	t.shrink_to_fit();
+	std::cout << t.size() << " " << t.column<0>().size() << " " << t.column<2>().size() << " " << t[0].get<0>()
+	          << " " << t[0].get<1>() << std::endl;
+}
+
+void TestRollback()
+{
+	std::cout << "Testing that the columns stay in sync when a field throws..." << std::endl;
+	sjtu::soa_vector<std::string, Fragile, int> t;
+	for (int i = 0; i < 10; ++i) {
+		t.push_back(std::to_string(i), Fragile(i), i);
+	}
+	int failures = 0;
+	for (int budget = 0; budget < 8; ++budget) {
+		Fragile::budget = budget % 2;
+		try {
+			if (budget < 4) {
+				t.push_back(std::string("new"), Fragile(100), 100);
+			} else {
+				t.insert(budget, std::make_tuple(std::string("ins"), Fragile(200), 200));
+			}
+		} catch (int) {
+			++failures;
+		}
+		Fragile::budget = -1;
+		std::cout << t.size() << " " << t.column<0>().size() << " " << t.column<1>().size() << " "
+		          << t.column<2>().size() << std::endl;
+	}
+	std::cout << failures << " " << t.back().get<1>().value() << std::endl;
+}
+
+int main()
+{
+	TestRows();
+	TestColumns();
+	TestRollback();
+	return 0;
+}
@@ -0,0 +1,116 @@
+#include "sort.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+unsigned long long seed = 20240101;
+
+unsigned long long Random()
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+// checks the result against std::sort / std::stable_sort of the same input.
+template<class T, class Compare = std::less<>>
+void Check(const char *name, const sjtu::vector<T> &input, Compare comp, sjtu::par::thread_pool &pool)
+{
+	std::vector<T> expected(input.begin(), input.end());
+	std::stable_sort(expected.begin(), expected.end(), comp);
+	sjtu::vector<T> a(input), b(input);
+	sjtu::sort(a.begin(), a.end(), comp, pool);
+	sjtu::stable_sort(b.begin(), b.end(), comp, pool);
+	bool sorted = std::is_sorted(a.begin(), a.end(), comp), same = true, stable = true;
+	for (size_t i = 0; i < input.size(); ++i) {
+		same = same && !comp(a[i], expected[i]) && !comp(expected[i], a[i]);
+		stable = stable && b[i] == expected[i];
+	}
+	std::cout << name << " " << input.size() << ": " << sorted << same << stable << std::endl;
+}
+
+void TestSort(size_t threads)
+{
+	std::cout << "Testing sort on " << threads << " threads..." << std::endl;
+	sjtu::par::thread_pool pool(threads);
+	for (size_t n : {0, 1, 100, 16383, 16384, 300000}) {
+		sjtu::vector<long long> v;
+		for (size_t i = 0; i < n; ++i) {
+			v.push_back((long long)Random());
+		}
+		if (n > 2) {
+			v[0] = LLONG_MIN;
+			v[1] = LLONG_MAX;
+			v[2] = -1;
+		}
+		Check("long long", v, std::less<>(), pool);
+	}
+	sjtu::vector<unsigned> u;
+	sjtu::vector<short> s;
+	sjtu::vector<int> small, equal(100000, 7), ascending, descending;
+	for (int i = 0; i < 200000; ++i) {
+		u.push_back((unsigned)Random());
+		s.push_back((short)Random());
+		small.push_back((int)(Random() % 300));
+		ascending.push_back(i);
+		descending.push_back(-i);
+	}
+	Check("unsigned", u, std::less<unsigned>(), pool);
+	Check("short", s, std::less<>(), pool);
+	// counting sorted on every pool.
+	sjtu::vector<signed char> bytes;
+	for (int i = 0; i < 100000; ++i) {
+		bytes.push_back((signed char)Random());
+	}
+	bytes[0] = SCHAR_MIN;
+	bytes[1] = SCHAR_MAX;
+	Check("signed char", bytes, std::less<>(), pool);
+	// counting sorted on 1 and 2 threads, radix sorted on 4.
+	sjtu::vector<unsigned short> wide;
+	for (int i = 0; i < 1100000; ++i) {
+		wide.push_back((unsigned short)(Random() % 60000 + 5000));
+	}
+	Check("unsigned short", wide, std::less<>(), pool);
+	Check("int small keys", small, std::less<>(), pool);
+	Check("int equal", equal, std::less<>(), pool);
+	Check("int ascending", ascending, std::less<>(), pool);
+	Check("int descending", descending, std::less<>(), pool);
+	Check("int greater", small, std::greater<>(), pool);
+	sjtu::vector<double> d;
+	for (int i = 0; i < 100000; ++i) {
+		d.push_back((double)(Random() % 100000) / 7 - 5000);
+	}
+	Check("double", d, std::less<>(), pool);
+}
+
+void TestStable(size_t threads)
+{
+	std::cout << "Testing stable_sort on " << threads << " threads..." << std::endl;
+	sjtu::par::thread_pool pool(threads);
+	sjtu::vector<std::pair<int, int>> v;
+	for (int i = 0; i < 250000; ++i) {
+		v.push_back({(int)(Random() % 1000), i});
+	}
+	auto by_key = [](const std::pair<int, int> &a, const std::pair<int, int> &b) { return a.first < b.first; };
+	Check("pair by key", v, by_key, pool);
+	sjtu::stable_sort(v.begin(), v.end(), by_key, pool);
+	bool stable = true;
+	for (size_t i = 1; i < v.size(); ++i) {
+		stable = stable && (v[i - 1].first < v[i].first || v[i - 1].second < v[i].second);
+	}
+	std::cout << stable << " " << v.front().first << " " << v.back().first << std::endl;
+}
+
+int main()
+{
+	for (size_t threads : {1, 2, 4}) {
+		TestSort(threads);
+		TestStable(threads);
+	}
+	return 0;
+}
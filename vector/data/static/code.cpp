@@ -0,0 +1,112 @@
+#include "vector.hpp"
+#include "class-integer.hpp"
+
+#include <initializer_list>
+#include <iostream>
+#include <string>
+
+template<class Vector>
+bool Inline(const Vector &v)
+{
+	const char *p = reinterpret_cast<const char *>(v.data()), *obj = reinterpret_cast<const char *>(&v);
+	return p >= obj && p < obj + sizeof(v);
+}
+
+// Integer has no accessor, so its elements are compared with expected values.
+template<size_t N>
+bool Matches(sjtu::static_vector<Integer, N> &v, std::initializer_list<int> values)
+{
+	if (v.size() != values.size()) {
+		return false;
+	}
+	size_t i = 0;
+	for (int x : values) {
+		if (!(v[i++] == Integer(x))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void TestInteger()
+{
+	std::cout << "Testing static_vector of a type without default constructor..." << std::endl;
+	sjtu::static_vector<Integer, 4> v;
+	std::cout << v.size() << " " << v.capacity() << " " << Inline(v) << std::endl;
+	v.push_back(Integer(1));
+	v.push_back(Integer(3));
+	v.insert(1, Integer(2));
+	v.insert(v.end(), Integer(4));
+	std::cout << Matches(v, {1, 2, 3, 4}) << " " << Inline(v) << std::endl;
+	v.erase(v.begin());
+	v.insert(v.begin() + 1, Integer(5));
+	std::cout << Matches(v, {2, 5, 3, 4}) << std::endl;
+	sjtu::static_vector<Integer, 4> copy(v);
+	copy.pop_back();
+	copy.pop_back();
+	v = copy;
+	std::cout << Matches(v, {2, 5}) << " " << Inline(v) << " " << Inline(copy) << std::endl;
+	v.resize(4, Integer(9));
+	std::cout << Matches(v, {2, 5, 9, 9}) << std::endl;
+}
+
+void TestOverflow()
+{
+	std::cout << "Testing overflow past N..." << std::endl;
+	sjtu::static_vector<Integer, 4> v(4, Integer(7));
+	try {
+		v.push_back(Integer(8));
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "push_back: runtime_error " << Matches(v, {7, 7, 7, 7}) << std::endl;
+	}
+	try {
+		v.insert(0, Integer(8));
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "insert: runtime_error " << Matches(v, {7, 7, 7, 7}) << std::endl;
+	}
+	v.pop_back();
+	try {
+		v.insert(1, 2, Integer(8));
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "insert count: runtime_error " << Matches(v, {7, 7, 7}) << std::endl;
+	}
+	try {
+		v.reserve(5);
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "reserve: runtime_error " << v.capacity() << std::endl;
+	}
+	try {
+		sjtu::static_vector<std::string, 2> s(3, std::string("x"));
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "construct: runtime_error" << std::endl;
+	}
+	v.push_back(Integer(6));
+	v.shrink_to_fit();
+	std::cout << Matches(v, {7, 7, 7, 6}) << " " << v.capacity() << " " << Inline(v) << std::endl;
+}
+
+void TestBool()
+{
+	std::cout << "Testing static_vector<bool, N>..." << std::endl;
+	sjtu::static_vector<bool, 100> v;
+	std::cout << v.capacity() << std::endl;
+	for (int i = 0; i < 128; ++i) {
+		v.push_back(i % 5 == 0);
+	}
+	std::cout << v.size() << " " << v.count() << std::endl;
+	try {
+		v.push_back(true);
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "runtime_error " << v.size() << " " << v.count() << std::endl;
+	}
+	sjtu::static_vector<bool, 64> w(64, true);
+	std::cout << w.capacity() << " " << w.count() << std::endl;
+}
+
+int main()
+{
+	TestInteger();
+	TestOverflow();
+	TestBool();
+	return 0;
+}
@@ -0,0 +1,98 @@
+#define SJTU_CONTAINER_STATS
+#include "vector.hpp"
+
+#include <iostream>
+#include <string>
+
+template<class V>
+void Print(const V &v)
+{
+	std::cout << v.size() << " " << v.capacity() << " " << v.stats().to_json() << std::endl;
+}
+
+void TestGrowth()
+{
+	std::cout << "Testing push_back, reserve and shrink_to_fit..." << std::endl;
+	sjtu::vector<int> v;
+	Print(v);
+	for (int i = 0; i < 20; ++i) {
+		v.push_back(i);
+	}
+	Print(v);
+	v.reserve(100);
+	Print(v);
+	v.reserve(50);
+	Print(v);
+	v.shrink_to_fit();
+	Print(v);
+	v.shrink_to_fit();
+	Print(v);
+	v.insert(v.begin(), -1);
+	Print(v);
+	v.erase(v.begin());
+	Print(v);
+	v.erase(v.begin() + 15, v.end());
+	Print(v);
+	v.pop_back();
+	Print(v);
+}
+
+void TestOwnership()
+{
+	std::cout << "Testing counters that stay with the object..." << std::endl;
+	sjtu::vector<long long> v(10, 7);
+	Print(v);
+	sjtu::vector<long long> copy = v;
+	Print(copy);
+	sjtu::vector<long long> moved = std::move(copy);
+	Print(moved);
+	sjtu::vector<long long> w;
+	w.swap(v);
+	Print(v);
+	Print(w);
+	w.reset_stats();
+	Print(w);
+	w.push_back(8);
+	Print(w);
+	w.clear();
+	Print(w);
+}
+
+void TestElementTypes()
+{
+	std::cout << "Testing other element types..." << std::endl;
+	sjtu::vector<std::string> s;
+	for (int i = 0; i < 9; ++i) {
+		s.push_back(std::to_string(i));
+	}
+	std::cout << s.stats().reallocations << " " << s.stats().bytes_copied / sizeof(std::string) << " "
+	          << s.stats().peak_capacity << std::endl;
+	sjtu::vector<bool> b;
+	for (int i = 0; i < 1000; ++i) {
+		b.push_back(i % 2 == 0);
+	}
+	Print(b);
+	b.reset_stats();
+	b.shrink_to_fit();
+	Print(b);
+}
+
+void TestJson()
+{
+	std::cout << "Testing to_json..." << std::endl;
+	sjtu::vector_stats stats;
+	std::cout << stats.to_json() << std::endl;
+	stats.reallocations = 3;
+	stats.bytes_copied = 18446744073709551615ull;
+	stats.peak_capacity = 42;
+	std::cout << stats.to_json() << std::endl;
+}
+
+int main()
+{
+	TestGrowth();
+	TestOwnership();
+	TestElementTypes();
+	TestJson();
+	return 0;
+}
@@ -0,0 +1,110 @@
+#include "tiered_vector.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+unsigned long long seed = 19260817;
+
+size_t Random(size_t n)
+{
+	seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+	return (size_t)(seed >> 33) % n;
+}
+
+template<class T>
+bool Same(const sjtu::tiered_vector<T> &v, const std::vector<T> &expected)
+{
+	if (v.size() != expected.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < expected.size(); ++i) {
+		if (v[i] != expected[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void TestRandomEdits()
+{
+	std::cout << "Testing random insertions and erasures..." << std::endl;
+	sjtu::tiered_vector<int> v;
+	std::vector<int> expected;
+	int mismatches = 0;
+	// grow to about 40000 elements and shrink back, so that the block size is rebuilt both ways.
+	for (int step = 0; step < 200000; ++step) {
+		bool grow = step < 100000 ? Random(10) < 7 : Random(10) < 3;
+		if (grow || expected.empty()) {
+			size_t ind = Random(expected.size() + 1);
+			v.insert(ind, step);
+			expected.insert(expected.begin() + ind, step);
+		} else {
+			size_t ind = Random(expected.size());
+			v.erase(ind);
+			expected.erase(expected.begin() + ind);
+		}
+		if (step % 5000 == 0 && !Same(v, expected)) {
+			++mismatches;
+		}
+	}
+	long long sum = 0;
+	for (int x : v) {
+		sum += x;
+	}
+	std::cout << mismatches << " " << Same(v, expected) << " " << v.size() << " " << sum << std::endl;
+	while (!v.empty()) {
+		v.erase(v.size() / 2);
+	}
+	std::cout << v.size() << std::endl;
+}
+
+void TestInterface()
+{
+	std::cout << "Testing the vector interface..." << std::endl;
+	sjtu::tiered_vector<std::string> v(3, std::string("s"));
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(std::to_string(i));
+	}
+	v.insert(v.begin() + 1, "second");
+	v.erase(v.begin() + 3);
+	v.pop_back();
+	v.front() = "first";
+	for (const std::string &s : v) {
+		std::cout << s << " ";
+	}
+	std::cout << std::endl;
+	std::cout << v.size() << " " << v.back() << " " << v.at(2) << " " << (v.end() - v.begin()) << std::endl;
+	try {
+		v.at(v.size());
+	} catch (const sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	try {
+		v.insert(v.size() + 1, "x");
+	} catch (const sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	sjtu::tiered_vector<std::string> c(v), m(std::move(v));
+	std::cout << c.size() << " " << m.size() << " " << v.size() << std::endl;
+	v = c;
+	v.insert(0, "zero");
+	swap(v, m);
+	std::cout << v.size() << " " << m.size() << " " << m.front() << std::endl;
+	v.clear();
+	try {
+		v.pop_back();
+	} catch (const sjtu::container_is_empty &) {
+		std::cout << "container_is_empty" << std::endl;
+	}
+	int a[] = {5, 6, 7};
+	sjtu::tiered_vector<int> r(a, a + 3);
+	std::cout << r.size() << " " << r[0] << r[1] << r[2] << std::endl;
+}
+
+int main()
+{
+	TestRandomEdits();
+	TestInterface();
+	return 0;
+}
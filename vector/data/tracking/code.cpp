@@ -0,0 +1,174 @@
+#define SJTU_TRACK_ALLOCATIONS
+#include "vector.hpp"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+sjtu::allocation_tracker &tracker = sjtu::allocation_tracker::instance();
+
+struct Counted {
+	static int destroyed;
+	int value;
+
+	explicit Counted(int value) : value(value) {}
+
+	~Counted()
+	{
+		destroyed++;
+	}
+};
+
+int Counted::destroyed = 0;
+
+struct alignas(64) Wide {
+	char bytes[64];
+};
+
+void PrintTracker()
+{
+	std::cout << tracker.live_blocks() << " " << tracker.live_bytes() << " " << tracker.double_frees() << " "
+	          << tracker.size_mismatches() << std::endl;
+}
+
+/**
+ * runs scenario in a child process that then exits normally, so that the reporter runs at its exit.
+ * prints the exit status and the first line of what the child wrote to stderr (the leaked blocks listed after
+ *   it carry addresses).
+ */
+template<class Scenario>
+void RunChild(Scenario scenario)
+{
+	std::cout.flush();
+	int fds[2];
+	if (pipe(fds) != 0) {
+		std::cout << "pipe failed" << std::endl;
+		return;
+	}
+	pid_t child = fork();
+	if (child == 0) {
+		close(fds[0]);
+		dup2(fds[1], 2);
+		scenario();
+		std::exit(0);
+	}
+	close(fds[1]);
+	int status = 0;
+	waitpid(child, &status, 0);
+	std::string err;
+	char buf[256];
+	ssize_t n;
+	while ((n = read(fds[0], buf, sizeof(buf))) > 0) {
+		err.append(buf, n);
+	}
+	close(fds[0]);
+	std::cout << "exit " << (WIFEXITED(status) ? WEXITSTATUS(status) : -1) << ": " << err.substr(0, err.find('\n'))
+	          << std::endl;
+}
+
+void TestVector()
+{
+	std::cout << "Testing the blocks of a vector..." << std::endl;
+	size_t allocations = tracker.allocations();
+	{
+		sjtu::vector<int> v;
+		for (int i = 0; i < 100; ++i) {
+			v.push_back(i);
+		}
+		std::cout << tracker.allocations() - allocations << " " << (tracker.live_bytes() == v.capacity() * sizeof(int))
+		          << " " << tracker.peak_bytes() << std::endl;
+		PrintTracker();
+		v.shrink_to_fit();
+		sjtu::vector<int> w = v;
+		std::cout << tracker.allocations() - allocations << " " << v.capacity() << " " << w.capacity() << std::endl;
+		PrintTracker();
+		sjtu::vector<int> moved = std::move(w);
+		std::cout << tracker.allocations() - allocations << std::endl;
+		PrintTracker();
+	}
+	PrintTracker();
+	sjtu::vector<Wide> wide(3);
+	std::cout << (reinterpret_cast<size_t>(wide.data()) % alignof(Wide)) << " " << tracker.live_bytes() << std::endl;
+}
+
+void TestObjects()
+{
+	std::cout << "Testing tracked_new and tracked_delete..." << std::endl;
+	size_t base = tracker.live_blocks();
+	Counted *a = sjtu::tracked_new<Counted>(1);
+	const Counted *b = sjtu::tracked_new<Counted>(2);
+	std::cout << tracker.live_blocks() - base << " " << a->value + b->value << std::endl;
+	sjtu::tracked_delete(a);
+	sjtu::tracked_delete(b);
+	sjtu::tracked_delete(static_cast<Counted *>(nullptr));
+	std::cout << tracker.live_blocks() - base << " " << Counted::destroyed << " " << tracker.double_frees()
+	          << std::endl;
+}
+
+void TestClean()
+{
+	std::cout << "Testing a clean run..." << std::endl;
+	RunChild([] {
+		sjtu::vector<std::string> v(10, "tracked");
+		v.insert(v.begin(), "front");
+	});
+}
+
+void TestLeak()
+{
+	std::cout << "Testing a leak..." << std::endl;
+	RunChild([] {
+		sjtu::tracking_allocator<int> alloc;
+		alloc.allocate(10);
+		sjtu::tracked_new<Counted>(3);
+		PrintTracker();
+	});
+}
+
+void TestDoubleFree()
+{
+	std::cout << "Testing double frees..." << std::endl;
+	RunChild([] {
+		sjtu::tracking_allocator<double> alloc;
+		double *p = alloc.allocate(4);
+		alloc.deallocate(p, 4);
+		alloc.deallocate(p, 4);
+		int local;
+		std::cout << tracker.deallocated(&local, sizeof(local)) << std::endl;
+		Counted::destroyed = 0;
+		Counted *c = sjtu::tracked_new<Counted>(4);
+		sjtu::tracked_delete(c);
+		sjtu::tracked_delete(c);
+		std::cout << Counted::destroyed << std::endl;
+		PrintTracker();
+	});
+}
+
+void TestSizeMismatch()
+{
+	std::cout << "Testing a size mismatch..." << std::endl;
+	RunChild([] {
+		size_t live = tracker.live_bytes();
+		sjtu::tracking_allocator<int> alloc;
+		int *p = alloc.allocate(8);
+		std::cout << tracker.live_bytes() - live << std::endl;
+		alloc.deallocate(p, 4);
+		std::cout << tracker.live_bytes() - live << std::endl;
+		PrintTracker();
+	});
+}
+
+int main()
+{
+	TestVector();
+	TestObjects();
+	TestClean();
+	TestLeak();
+	TestDoubleFree();
+	TestSizeMismatch();
+	return 0;
+}
@@ -0,0 +1,68 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <type_traits>
+
+void TestAccess()
+{
+	std::cout << "Testing reads and writes through the view..." << std::endl;
+	sjtu::vector<double> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i * 0.5);
+	}
+	sjtu::unchecked_view view(v);
+	static_assert(std::is_same<decltype(view), sjtu::unchecked_view<double>>::value, "deduced from a vector");
+	std::cout << view.size() << " " << view.empty() << " " << (view.data() == v.data()) << " "
+	          << (view.end() - view.begin()) << std::endl;
+	for (size_t i = 0; i < view.size(); ++i) {
+		view[i] *= 2;
+	}
+	view.front() = -1;
+	view.back() += 100;
+	double sum = 0;
+	for (double x : view) {
+		sum += x;
+	}
+	std::cout << v[0] << " " << v[1] << " " << v[9] << " " << sum << std::endl;
+	v[4] = 42;
+	std::cout << view[4] << std::endl;
+	const sjtu::vector<double> &cv = v;
+	sjtu::unchecked_view cview(cv);
+	static_assert(std::is_same<decltype(cview), sjtu::unchecked_view<const double>>::value,
+	              "deduced from a const vector");
+	static_assert(std::is_same<decltype(cview[0]), const double &>::value, "read-only access");
+	sjtu::unchecked_view<const double> from_mutable(v);
+	std::cout << cview[4] << " " << from_mutable.back() << std::endl;
+}
+
+void TestChecks()
+{
+	std::cout << "Testing bounds checks without NDEBUG..." << std::endl;
+	sjtu::vector<int> v(3, 7);
+	sjtu::unchecked_view view(v);
+	try {
+		view[3] = 1;
+	} catch (const sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	sjtu::vector<int> empty;
+	sjtu::unchecked_view empty_view(empty);
+	try {
+		empty_view.front();
+	} catch (const sjtu::container_is_empty &) {
+		std::cout << "container_is_empty" << std::endl;
+	}
+	try {
+		empty_view.back();
+	} catch (const sjtu::container_is_empty &) {
+		std::cout << "container_is_empty" << std::endl;
+	}
+	std::cout << empty_view.empty() << " " << (empty_view.begin() == empty_view.end()) << " " << view[2] << std::endl;
+}
+
+int main()
+{
+	TestAccess();
+	TestChecks();
+	return 0;
+}
@@ -0,0 +1,329 @@
+#ifndef SJTU_ALLOCATOR_HPP
+#define SJTU_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace sjtu {
+
+/**
+ * a memory resource handing out memory by bumping a pointer through large chunks.
+ * deallocation does nothing: reset() takes back everything allocated so far at once,
+ *   so the containers using it must be destroyed (or hold trivially destructible elements) before the reset.
+ * not thread-safe.
+ */
+class monotonic_arena {
+public:
+  explicit monotonic_arena(size_t initial_chunk_size = 4096)
+      : head_(nullptr), cur_(nullptr), end_(nullptr), next_chunk_size_(initial_chunk_size), allocated_(0) {}
+
+  monotonic_arena(const monotonic_arena &other) = delete;
+
+  monotonic_arena &operator=(const monotonic_arena &other) = delete;
+
+  ~monotonic_arena() {
+    FreeChunks(head_);
+  }
+
+  void *allocate(size_t bytes, size_t alignment) {
+    size_t padding = (alignment - reinterpret_cast<size_t>(cur_) % alignment) % alignment;
+    if (cur_ == nullptr || static_cast<size_t>(end_ - cur_) < padding + bytes) {
+      NewChunk(bytes + alignment);
+      padding = (alignment - reinterpret_cast<size_t>(cur_) % alignment) % alignment;
+    }
+    char *res = cur_ + padding;
+    cur_ = res + bytes;
+    allocated_ += bytes;
+    return res;
+  }
+
+  /**
+   * gives back all the memory allocated from the arena.
+   * the latest (and largest) chunk is kept for reuse, the others are freed.
+   */
+  void reset() {
+    if (head_ == nullptr) {
+      return;
+    }
+    FreeChunks(head_->next_);
+    head_->next_ = nullptr;
+    cur_ = reinterpret_cast<char *>(head_ + 1);
+    end_ = reinterpret_cast<char *>(head_) + head_->size_;
+    allocated_ = 0;
+  }
+
+  /**
+   * returns the number of bytes handed out since the last reset.
+   */
+  size_t bytes_allocated() const {
+    return allocated_;
+  }
+
+private:
+  struct alignas(std::max_align_t) Chunk {
+    Chunk *next_;
+    size_t size_;
+  };
+
+  static void FreeChunks(Chunk *chunk) {
+    while (chunk != nullptr) {
+      Chunk *next = chunk->next_;
+      ::operator delete(chunk);
+      chunk = next;
+    }
+  }
+
+  void NewChunk(size_t min_bytes) {
+    size_t size = next_chunk_size_;
+    while (size < min_bytes + sizeof(Chunk)) {
+      size *= 2;
+    }
+    Chunk *chunk = static_cast<Chunk *>(::operator new(size));
+    chunk->next_ = head_;
+    chunk->size_ = size;
+    head_ = chunk;
+    cur_ = reinterpret_cast<char *>(chunk + 1);
+    end_ = reinterpret_cast<char *>(chunk) + size;
+    next_chunk_size_ = size * 2;
+  }
+
+  Chunk *head_;
+  char *cur_, *end_;
+  size_t next_chunk_size_, allocated_;
+};
+
+/**
+ * an allocator drawing from a monotonic_arena.
+ * it is moved and swapped along with the container, but a copy of a container keeps its own allocator.
+ */
+template<typename T>
+class monotonic_arena_allocator {
+public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  monotonic_arena_allocator(monotonic_arena *arena) : arena_(arena) {}
+
+  template<typename U>
+  monotonic_arena_allocator(const monotonic_arena_allocator<U> &other) : arena_(other.arena()) {}
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *, size_t) {}
+
+  monotonic_arena *arena() const {
+    return arena_;
+  }
+
+  template<typename U>
+  bool operator==(const monotonic_arena_allocator<U> &rhs) const {
+    return arena_ == rhs.arena();
+  }
+
+  template<typename U>
+  bool operator!=(const monotonic_arena_allocator<U> &rhs) const {
+    return arena_ != rhs.arena();
+  }
+
+private:
+  monotonic_arena *arena_;
+};
+
+/**
+ * a memory resource keeping freed blocks in free lists for reuse.
+ * requests are rounded up to a power of two between 16 bytes and 64 KiB, each size having its own list;
+ *   bigger requests go to operator new directly.
+ * blocks are carved from chunks which are only given back by release() or the destructor.
+ * not thread-safe.
+ */
+class pool_resource {
+public:
+  pool_resource() : chunks_(nullptr) {
+    for (size_t i = 0; i < kClasses; i++) {
+      free_[i] = nullptr;
+    }
+  }
+
+  pool_resource(const pool_resource &other) = delete;
+
+  pool_resource &operator=(const pool_resource &other) = delete;
+
+  ~pool_resource() {
+    release();
+  }
+
+  void *allocate(size_t bytes, size_t alignment) {
+    size_t cls = ClassOf(bytes);
+    if (cls == kClasses || alignment > alignof(std::max_align_t)) {
+      return ::operator new(bytes, std::align_val_t(alignment));
+    }
+    if (free_[cls] == nullptr) {
+      Refill(cls);
+    }
+    Block *res = free_[cls];
+    free_[cls] = res->next_;
+    return res;
+  }
+
+  void deallocate(void *p, size_t bytes, size_t alignment) {
+    size_t cls = ClassOf(bytes);
+    if (cls == kClasses || alignment > alignof(std::max_align_t)) {
+      ::operator delete(p, std::align_val_t(alignment));
+      return;
+    }
+    Block *block = static_cast<Block *>(p);
+    block->next_ = free_[cls];
+    free_[cls] = block;
+  }
+
+  /**
+   * gives back every chunk; all blocks handed out become invalid.
+   */
+  void release() {
+    while (chunks_ != nullptr) {
+      Block *next = chunks_->next_;
+      ::operator delete(chunks_);
+      chunks_ = next;
+    }
+    for (size_t i = 0; i < kClasses; i++) {
+      free_[i] = nullptr;
+    }
+  }
+
+private:
+  struct Block {
+    Block *next_;
+  };
+
+  static const size_t kMinBlock = 16;
+  static const size_t kClasses = 13;  // 16 B ... 64 KiB
+  static const size_t kChunkSize = 64 * 1024;
+
+  static size_t ClassOf(size_t bytes) {
+    size_t cls = 0;
+    while (cls < kClasses && (kMinBlock << cls) < bytes) {
+      cls++;
+    }
+    return cls;
+  }
+
+  // carve a new chunk into blocks of class cls. the first max_align_t bytes of the chunk link it into chunks_.
+  void Refill(size_t cls) {
+    size_t block_size = kMinBlock << cls;
+    size_t header = alignof(std::max_align_t);
+    size_t count = (kChunkSize - header) / block_size;
+    if (count == 0) {
+      count = 1;
+    }
+    char *chunk = static_cast<char *>(::operator new(header + count * block_size));
+    reinterpret_cast<Block *>(chunk)->next_ = chunks_;
+    chunks_ = reinterpret_cast<Block *>(chunk);
+    for (size_t i = count; i-- > 0;) {
+      Block *block = reinterpret_cast<Block *>(chunk + header + i * block_size);
+      block->next_ = free_[cls];
+      free_[cls] = block;
+    }
+  }
+
+  Block *chunks_;
+  Block *free_[kClasses];
+};
+
+/**
+ * an allocator drawing from a pool_resource.
+ * it is moved and swapped along with the container, but a copy of a container keeps its own allocator.
+ */
+template<typename T>
+class pool_allocator {
+public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  pool_allocator(pool_resource *pool) : pool_(pool) {}
+
+  template<typename U>
+  pool_allocator(const pool_allocator<U> &other) : pool_(other.pool()) {}
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(pool_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *p, size_t n) {
+    pool_->deallocate(p, n * sizeof(T), alignof(T));
+  }
+
+  pool_resource *pool() const {
+    return pool_;
+  }
+
+  template<typename U>
+  bool operator==(const pool_allocator<U> &rhs) const {
+    return pool_ == rhs.pool();
+  }
+
+  template<typename U>
+  bool operator!=(const pool_allocator<U> &rhs) const {
+    return pool_ != rhs.pool();
+  }
+
+private:
+  pool_resource *pool_;
+};
+
+/**
+ * an allocator returning blocks aligned to Alignment bytes (a cache line by default), so that a vector using it
+ *   has data() aligned for aligned SIMD loads and never splits an element group across two cache lines.
+ * Alignment must be a power of two and at least alignof(T).
+ */
+template<typename T, size_t Alignment = 64>
+class aligned_allocator {
+  static_assert((Alignment & (Alignment - 1)) == 0, "the alignment must be a power of two");
+  static_assert(Alignment >= alignof(T), "the alignment must be at least that of T");
+
+public:
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  static const size_t alignment = Alignment;
+
+  template<typename U>
+  struct rebind {
+    using other = aligned_allocator<U, (Alignment > alignof(U) ? Alignment : alignof(U))>;
+  };
+
+  aligned_allocator() = default;
+
+  template<typename U, size_t A>
+  aligned_allocator(const aligned_allocator<U, A> &) {}
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+  }
+
+  void deallocate(T *p, size_t) {
+    ::operator delete(p, std::align_val_t(Alignment));
+  }
+
+  template<typename U, size_t A>
+  bool operator==(const aligned_allocator<U, A> &) const {
+    return true;
+  }
+
+  template<typename U, size_t A>
+  bool operator!=(const aligned_allocator<U, A> &) const {
+    return false;
+  }
+};
+
+}
+
+#endif
@@ -0,0 +1,605 @@
+#ifndef SJTU_CONCURRENT_VECTOR_HPP
+#define SJTU_CONCURRENT_VECTOR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "exceptions.hpp"
+
+namespace sjtu {
+
+/**
+ * a vector which many threads can append to at once.
+ * the elements live in segments of doubling size which are never moved or freed before clear(), so appending
+ *   never invalidates references, pointers or iterators.
+ * push_back, emplace_back and grow_by reserve their slots with one atomic fetch_add and construct the
+ *   elements in place; a missing segment is allocated by whichever thread needs it first and published with a
+ *   compare-and-swap. no lock is taken.
+ * size() counts the published elements, which are always the constructed prefix: an append whose slots come
+ *   next publishes them and every ready slot after them, while one finishing ahead of an earlier append marks
+ *   its slots ready in a bitmap and leaves them to it instead of waiting. indexed reads, at(), back() and
+ *   iteration up to size() are thus safe concurrently with appends.
+ * clear(), swap, assignment and destruction must not run concurrently with anything else. the allocator is used
+ *   by every appending thread, so a stateful one must be thread-safe.
+ * if constructing an appended element throws, its slot is never marked ready, so neither it nor any element
+ *   after it is ever published; clear() and the destructor still destroy every element that was constructed.
+ *   the element constructors used for appending should therefore not throw.
+ */
+template<typename T, typename Allocator = std::allocator<T>>
+class concurrent_vector {
+public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+
+private:
+  template<bool Const>
+  class Iterator {
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+    using iterator_category = std::random_access_iterator_tag;
+
+  private:
+    friend class concurrent_vector;
+    friend class Iterator<!Const>;
+
+    using Container = std::conditional_t<Const, const concurrent_vector, concurrent_vector>;
+
+    Container *vec_ptr_;
+    size_t index_;
+
+    Iterator(Container *vec_ptr, size_t index) : vec_ptr_(vec_ptr), index_(index) {}
+
+  public:
+    Iterator() : vec_ptr_(nullptr), index_(0) {}
+
+    template<bool OtherConst, class = std::enable_if_t<Const && !OtherConst>>
+    Iterator(const Iterator<OtherConst> &other) : vec_ptr_(other.vec_ptr_), index_(other.index_) {}
+
+    Iterator operator+(difference_type n) const {
+      return {vec_ptr_, index_ + n};
+    }
+
+    friend Iterator operator+(difference_type n, const Iterator &it) {
+      return it + n;
+    }
+
+    Iterator operator-(difference_type n) const {
+      return {vec_ptr_, index_ - n};
+    }
+
+    // if these two iterators point to different containers, throw invaild_iterator.
+    difference_type operator-(const Iterator &rhs) const {
+      if (vec_ptr_ != rhs.vec_ptr_) {
+        throw invalid_iterator();
+      }
+      return static_cast<difference_type>(index_ - rhs.index_);
+    }
+
+    Iterator &operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+
+    Iterator &operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator old = *this;
+      ++index_;
+      return old;
+    }
+
+    Iterator &operator++() {
+      ++index_;
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      Iterator old = *this;
+      --index_;
+      return old;
+    }
+
+    Iterator &operator--() {
+      --index_;
+      return *this;
+    }
+
+    reference operator*() const {
+      return vec_ptr_->Element(index_);
+    }
+
+    pointer operator->() const {
+      return &vec_ptr_->Element(index_);
+    }
+
+    reference operator[](difference_type n) const {
+      return vec_ptr_->Element(index_ + n);
+    }
+
+    bool operator==(const Iterator &rhs) const {
+      return vec_ptr_ == rhs.vec_ptr_ && index_ == rhs.index_;
+    }
+
+    bool operator!=(const Iterator &rhs) const {
+      return !(*this == rhs);
+    }
+
+    bool operator<(const Iterator &rhs) const {
+      return index_ < rhs.index_;
+    }
+
+    bool operator>(const Iterator &rhs) const {
+      return index_ > rhs.index_;
+    }
+
+    bool operator<=(const Iterator &rhs) const {
+      return index_ <= rhs.index_;
+    }
+
+    bool operator>=(const Iterator &rhs) const {
+      return index_ >= rhs.index_;
+    }
+  };
+
+public:
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  concurrent_vector() : concurrent_vector(Allocator()) {}
+
+  explicit concurrent_vector(const Allocator &alloc) : alloc_(alloc), reserved_(0), size_(0) {
+    for (size_t k = 0; k < kMaxSegments; k++) {
+      segments_[k].store(nullptr, std::memory_order_relaxed);
+      ready_[k].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  concurrent_vector(const concurrent_vector &other)
+      : concurrent_vector(AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+    try {
+      AppendFrom(other);
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
+  concurrent_vector(concurrent_vector &&other) : concurrent_vector(other.alloc_) {
+    SwapStorage(other);
+  }
+
+  /**
+   * the allocator of other is taken over only if it propagates on copy / move assignment. a move between unequal
+   *   allocators that do not propagate moves the elements one by one.
+   */
+  concurrent_vector &operator=(const concurrent_vector &other) {
+    if (this == &other) {
+      return *this;
+    }
+    constexpr bool kPropagate = AllocTraits::propagate_on_container_copy_assignment::value;
+    concurrent_vector tmp(kPropagate ? other.alloc_ : alloc_);
+    tmp.AppendFrom(other);
+    clear();
+    if constexpr (kPropagate) {
+      alloc_ = other.alloc_;
+    }
+    SwapStorage(tmp);
+    return *this;
+  }
+
+  concurrent_vector &operator=(concurrent_vector &&other) {
+    if (this == &other) {
+      return *this;
+    }
+    clear();
+    if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+      alloc_ = other.alloc_;
+      SwapStorage(other);
+    } else if (SameAllocator(other)) {
+      SwapStorage(other);
+    } else {
+      AppendFrom(std::move(other));
+      other.clear();
+    }
+    return *this;
+  }
+
+  ~concurrent_vector() {
+    clear();
+  }
+
+  /**
+   * exchanges the contents with other.
+   * the allocators are exchanged if the allocator propagates on swap; otherwise the segments are exchanged when
+   *   the allocators are equal, and the elements are moved one by one when they are not.
+   */
+  void swap(concurrent_vector &other) {
+    if (this == &other) {
+      return;
+    }
+    if constexpr (AllocTraits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(alloc_, other.alloc_);
+      SwapStorage(other);
+    } else {
+      if (SameAllocator(other)) {
+        SwapStorage(other);
+        return;
+      }
+      concurrent_vector tmp(std::move(other));
+      other = std::move(*this);
+      *this = std::move(tmp);
+    }
+  }
+
+  friend void swap(concurrent_vector &lhs, concurrent_vector &rhs) {
+    lhs.swap(rhs);
+  }
+
+  allocator_type get_allocator() const {
+    return alloc_;
+  }
+
+
+  /**
+   * access specified element with bounds checking
+   * throw index_out_of_bound if pos is not in [0, size)
+   */
+  T &at(const size_t &pos) {
+    if (pos >= size()) {
+      throw index_out_of_bound();
+    }
+    return Element(pos);
+  }
+
+  const T &at(const size_t &pos) const {
+    if (pos >= size()) {
+      throw index_out_of_bound();
+    }
+    return Element(pos);
+  }
+
+  T &operator[](const size_t &pos) {
+    return at(pos);
+  }
+
+  const T &operator[](const size_t &pos) const {
+    return at(pos);
+  }
+
+  /**
+   * access the first / last element.
+   * throw container_is_empty if size == 0
+   */
+  const T &front() const {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    return Element(0);
+  }
+
+  const T &back() const {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    return Element(size() - 1);
+  }
+
+  /**
+   * the iterators cover the elements published when end() is called.
+   */
+  iterator begin() {
+    return {this, 0};
+  }
+
+  const_iterator begin() const {
+    return {this, 0};
+  }
+
+  const_iterator cbegin() const {
+    return {this, 0};
+  }
+
+  iterator end() {
+    return {this, size()};
+  }
+
+  const_iterator end() const {
+    return {this, size()};
+  }
+
+  const_iterator cend() const {
+    return {this, size()};
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  size_t size() const {
+    return size_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * returns the number of elements the allocated segments can hold without allocating.
+   */
+  size_t capacity() const {
+    size_t k = 0;
+    while (k < kMaxSegments && segments_[k].load(std::memory_order_acquire) != nullptr) {
+      k++;
+    }
+    return SegmentBase(k);
+  }
+
+  /**
+   * allocates the segments needed to hold n elements. safe to call concurrently with appends and reads.
+   */
+  void reserve(size_t n) {
+    if (n > 0) {
+      EnsureSegments(0, n);
+    }
+  }
+
+  /**
+   * destroys every element and frees every segment.
+   */
+  void clear() {
+    size_t n = size_.load(std::memory_order_relaxed);
+    for (size_t k = 0; k < kMaxSegments; k++) {
+      T *segment = segments_[k].load(std::memory_order_relaxed);
+      Word *ready = ready_[k].load(std::memory_order_relaxed);
+      if (segment != nullptr) {
+        // the constructed elements are the published ones and those marked ready after them.
+        for (size_t i = 0; i < SegmentSize(k); i++) {
+          bool marked = ready != nullptr && (ready[i / 64].load(std::memory_order_relaxed) >> (i % 64) & 1);
+          if (SegmentBase(k) + i < n || marked) {
+            AllocTraits::destroy(alloc_, segment + i);
+          }
+        }
+        AllocTraits::deallocate(alloc_, segment, SegmentSize(k));
+        segments_[k].store(nullptr, std::memory_order_relaxed);
+      }
+      if (ready != nullptr) {
+        WordAllocator word_alloc(alloc_);
+        WordTraits::deallocate(word_alloc, ready, ReadyWords(k));
+        ready_[k].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+    reserved_.store(0, std::memory_order_relaxed);
+    size_.store(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * appends value and returns an iterator to it. safe to call concurrently with other appends and reads.
+   */
+  iterator push_back(const T &value) {
+    return emplace_back(value);
+  }
+
+  iterator push_back(T &&value) {
+    return emplace_back(std::move(value));
+  }
+
+  template<class... Args>
+  iterator emplace_back(Args &&...args) {
+    size_t ind = reserved_.fetch_add(1);
+    EnsureSegments(ind, ind + 1);
+    AllocTraits::construct(alloc_, &Element(ind), std::forward<Args>(args)...);
+    Publish(ind, ind + 1);
+    return {this, ind};
+  }
+
+  /**
+   * appends n copies of value as one contiguous block of indices and returns an iterator to the first of them.
+   * safe to call concurrently with other appends and reads.
+   */
+  iterator grow_by(size_t n, const T &value = T()) {
+    if (n == 0) {
+      return end();
+    }
+    size_t ind = reserved_.fetch_add(n), i = ind;
+    EnsureSegments(ind, ind + n);
+    try {
+      for (; i < ind + n; i++) {
+        AllocTraits::construct(alloc_, &Element(i), value);
+      }
+    } catch (...) {
+      while (i-- > ind) {
+        AllocTraits::destroy(alloc_, &Element(i));
+      }
+      throw;
+    }
+    Publish(ind, ind + n);
+    return {this, ind};
+  }
+
+private:
+  using AllocTraits = std::allocator_traits<Allocator>;
+  using Word = std::atomic<uint64_t>;
+  using WordAllocator = typename AllocTraits::template rebind_alloc<Word>;
+  using WordTraits = std::allocator_traits<WordAllocator>;
+
+  // segment k holds the indices [kFirstSegment * (2^k - 1), kFirstSegment * (2^(k+1) - 1)).
+  static const size_t kFirstSegment = 8;
+  static const size_t kMaxSegments = 61;
+
+  static size_t SegmentOf(size_t ind) {
+    return 63 - __builtin_clzll(ind / kFirstSegment + 1);
+  }
+
+  static size_t SegmentBase(size_t k) {
+    return kFirstSegment * ((size_t(1) << k) - 1);
+  }
+
+  static size_t SegmentSize(size_t k) {
+    return kFirstSegment << k;
+  }
+
+  // the number of words in the ready bitmap of segment k.
+  static size_t ReadyWords(size_t k) {
+    return (SegmentSize(k) + 63) / 64;
+  }
+
+  T &Element(size_t ind) {
+    size_t k = SegmentOf(ind);
+    return segments_[k].load(std::memory_order_acquire)[ind - SegmentBase(k)];
+  }
+
+  const T &Element(size_t ind) const {
+    size_t k = SegmentOf(ind);
+    return segments_[k].load(std::memory_order_acquire)[ind - SegmentBase(k)];
+  }
+
+  // make sure every segment holding an index in [first, last), and its ready bitmap, is allocated. when two
+  // threads race for a block, the loser of the compare-and-swap frees its own.
+  void EnsureSegments(size_t first, size_t last) {
+    for (size_t k = SegmentOf(first), end = SegmentOf(last - 1); k <= end; k++) {
+      if (ready_[k].load(std::memory_order_acquire) == nullptr) {
+        WordAllocator word_alloc(alloc_);
+        Word *ready = WordTraits::allocate(word_alloc, ReadyWords(k));
+        for (size_t w = 0; w < ReadyWords(k); w++) {
+          WordTraits::construct(word_alloc, ready + w, 0);
+        }
+        Word *expected = nullptr;
+        if (!ready_[k].compare_exchange_strong(expected, ready, std::memory_order_acq_rel)) {
+          WordTraits::deallocate(word_alloc, ready, ReadyWords(k));
+        }
+      }
+      if (segments_[k].load(std::memory_order_acquire) == nullptr) {
+        T *segment = AllocTraits::allocate(alloc_, SegmentSize(k));
+        T *expected = nullptr;
+        if (!segments_[k].compare_exchange_strong(expected, segment, std::memory_order_acq_rel)) {
+          AllocTraits::deallocate(alloc_, segment, SegmentSize(k));
+        }
+      }
+    }
+  }
+
+  // returns the end of the run of slots marked ready starting at ind, a word at a time.
+  size_t ReadyEnd(size_t ind) const {
+    while (true) {
+      size_t k = SegmentOf(ind), i = ind - SegmentBase(k);
+      const Word *ready = ready_[k].load(std::memory_order_acquire);
+      if (ready == nullptr) {
+        return ind;
+      }
+      uint64_t rest = ~(ready[i / 64].load() >> (i % 64));
+      size_t run = (rest == 0 ? 64 : __builtin_ctzll(rest)), left = 64 - i % 64;
+      if (left > SegmentSize(k) - i) {
+        left = SegmentSize(k) - i;
+      }
+      if (run < left) {
+        return ind + run;
+      }
+      ind += left;
+    }
+  }
+
+  // publish the constructed elements [first, last): if they come next, move size_ past them and then past every
+  // slot marked ready after them; otherwise mark them ready for the append that publishes the slots before them.
+  // the operations are sequentially consistent so that of an append marking slot i and one moving size_ to i,
+  // at least one sees the other's write: either the mover sees slot i ready, or the marker sees size_ at i.
+  // after each move the scan starts again, since slots may have been marked while it was running.
+  void Publish(size_t first, size_t last) {
+    size_t cur = first;
+    if (size_.compare_exchange_strong(cur, last)) {
+      // no slot reserved after last yet: whoever reserves one will find size_ at last and publish it itself.
+      if (reserved_.load() == last) {
+        return;
+      }
+      cur = last;
+    } else {
+      for (size_t ind = first; ind < last;) {
+        // the bits of [ind, last) in one word of one segment.
+        size_t k = SegmentOf(ind), i = ind - SegmentBase(k), bits = 64 - i % 64;
+        if (bits > SegmentSize(k) - i) {
+          bits = SegmentSize(k) - i;
+        }
+        if (bits > last - ind) {
+          bits = last - ind;
+        }
+        uint64_t mask = (bits == 64 ? ~uint64_t(0) : ((uint64_t(1) << bits) - 1)) << (i % 64);
+        ready_[k].load(std::memory_order_acquire)[i / 64].fetch_or(mask);
+        ind += bits;
+      }
+      cur = size_.load();
+    }
+    while (true) {
+      size_t next = ReadyEnd(cur);
+      if (next == cur) {
+        return;
+      }
+      // on failure cur is reloaded, on success the scan goes on from next.
+      if (size_.compare_exchange_strong(cur, next)) {
+        cur = next;
+      }
+    }
+  }
+
+  bool SameAllocator(const concurrent_vector &other) const {
+    if constexpr (AllocTraits::is_always_equal::value) {
+      return true;
+    } else {
+      return alloc_ == other.alloc_;
+    }
+  }
+
+  // exchange the elements, leaving the allocators in place.
+  void SwapStorage(concurrent_vector &other) {
+    size_t size = size_.load(std::memory_order_relaxed);
+    size_.store(other.size_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    other.size_.store(size, std::memory_order_relaxed);
+    size = reserved_.load(std::memory_order_relaxed);
+    reserved_.store(other.reserved_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    other.reserved_.store(size, std::memory_order_relaxed);
+    for (size_t k = 0; k < kMaxSegments; k++) {
+      T *segment = segments_[k].load(std::memory_order_relaxed);
+      segments_[k].store(other.segments_[k].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      other.segments_[k].store(segment, std::memory_order_relaxed);
+      Word *ready = ready_[k].load(std::memory_order_relaxed);
+      ready_[k].store(other.ready_[k].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      other.ready_[k].store(ready, std::memory_order_relaxed);
+    }
+  }
+
+  // append copies of the elements of other to this empty vector, or move them if other is an rvalue.
+  template<class Other>
+  void AppendFrom(Other &&other) {
+    size_t n = other.size();
+    reserve(n);
+    for (size_t i = 0; i < n; i++) {
+      if constexpr (std::is_lvalue_reference<Other>::value) {
+        AllocTraits::construct(alloc_, &Element(i), other.Element(i));
+      } else {
+        AllocTraits::construct(alloc_, &Element(i), std::move(other.Element(i)));
+      }
+      reserved_.store(i + 1, std::memory_order_relaxed);
+      Publish(i, i + 1);
+    }
+  }
+
+  Allocator alloc_;
+  // reserved_ counts the slots handed out, size_ the published elements.
+  std::atomic<size_t> reserved_, size_;
+  std::atomic<T *> segments_[kMaxSegments];
+  // a bit per slot of each segment, set when the element in it was constructed ahead of an earlier one.
+  std::atomic<Word *> ready_[kMaxSegments];
+};
+
+}
+
+#endif
@@ -0,0 +1,306 @@
+#ifndef SJTU_COW_VECTOR_HPP
+#define SJTU_COW_VECTOR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+namespace sjtu {
+
+/**
+ * a copy-on-write vector: copies share one reference-counted sjtu::vector, and a cow_vector copies the
+ *   elements only when it is about to be modified while shared, so passing it by value costs no more than a
+ *   pointer copy and an atomic increment.
+ * the count is atomic, so copies of one cow_vector may be made, read and destroyed in different threads; a
+ *   single cow_vector object is no more thread-safe than a vector.
+ * the const members never copy. the non-const ones first make the buffer private; those handing out a
+ *   mutable reference, pointer or iterator also mark it unshareable, so later copies are deep and cannot be
+ *   written through the reference. clear() and assignment make the buffer shareable again.
+ */
+template<typename T, typename Allocator = std::allocator<T>>
+class cow_vector {
+public:
+  using vector_type = vector<T, Allocator>;
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = typename vector_type::iterator;
+  using const_iterator = typename vector_type::const_iterator;
+
+  cow_vector() : rep_(nullptr) {}
+
+  cow_vector(const vector_type &other) : rep_(new Rep(other)) {}
+
+  cow_vector(vector_type &&other) : rep_(new Rep(std::move(other))) {}
+
+  cow_vector(size_t count, const T &value, const Allocator &alloc = Allocator())
+      : rep_(new Rep(vector_type(count, value, alloc))) {}
+
+  template<class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  cow_vector(InputIt first, InputIt last, const Allocator &alloc = Allocator())
+      : rep_(new Rep(vector_type(first, last, alloc))) {}
+
+  cow_vector(const cow_vector &other) : rep_(other.Share()) {}
+
+  cow_vector(cow_vector &&other) noexcept : rep_(other.rep_) {
+    other.rep_ = nullptr;
+  }
+
+  cow_vector &operator=(const cow_vector &other) {
+    if (this != &other) {
+      Rep *rep = other.Share();
+      Release();
+      rep_ = rep;
+    }
+    return *this;
+  }
+
+  cow_vector &operator=(cow_vector &&other) noexcept {
+    if (this != &other) {
+      Release();
+      rep_ = other.rep_;
+      other.rep_ = nullptr;
+    }
+    return *this;
+  }
+
+  ~cow_vector() {
+    Release();
+  }
+
+  void swap(cow_vector &other) noexcept {
+    std::swap(rep_, other.rep_);
+  }
+
+  friend void swap(cow_vector &lhs, cow_vector &rhs) noexcept {
+    lhs.swap(rhs);
+  }
+
+  /**
+   * returns the number of cow_vector objects sharing the buffer (0 for an empty one without a buffer).
+   */
+  size_t use_count() const {
+    return rep_ == nullptr ? 0 : rep_->refs_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * the shared vector, read-only.
+   */
+  const vector_type &view() const {
+    return rep_ == nullptr ? Empty() : rep_->data_;
+  }
+
+  /**
+   * access specified element with bounds checking
+   * throw index_out_of_bound if pos is not in [0, size)
+   */
+  T &at(const size_t &pos) {
+    return Mutable(false).at(pos);
+  }
+
+  const T &at(const size_t &pos) const {
+    return view().at(pos);
+  }
+
+  T &operator[](const size_t &pos) {
+    return Mutable(false)[pos];
+  }
+
+  const T &operator[](const size_t &pos) const {
+    return view()[pos];
+  }
+
+  /**
+   * access the first / last element.
+   * throw container_is_empty if size == 0
+   */
+  T &front() {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    return Mutable(false)[0];
+  }
+
+  const T &front() const {
+    return view().front();
+  }
+
+  T &back() {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    vector_type &v = Mutable(false);
+    return v[v.size() - 1];
+  }
+
+  const T &back() const {
+    return view().back();
+  }
+
+  iterator begin() {
+    return Mutable(false).begin();
+  }
+
+  const_iterator begin() const {
+    return view().cbegin();
+  }
+
+  const_iterator cbegin() const {
+    return view().cbegin();
+  }
+
+  iterator end() {
+    return Mutable(false).end();
+  }
+
+  const_iterator end() const {
+    return view().cend();
+  }
+
+  const_iterator cend() const {
+    return view().cend();
+  }
+
+  T *data() {
+    return Mutable(false).data();
+  }
+
+  const T *data() const {
+    return view().data();
+  }
+
+  bool empty() const {
+    return view().empty();
+  }
+
+  size_t size() const {
+    return view().size();
+  }
+
+  size_t capacity() const {
+    return view().capacity();
+  }
+
+  void reserve(size_t new_cap) {
+    Mutable(true).reserve(new_cap);
+  }
+
+  void resize(size_t count) {
+    Mutable(true).resize(count);
+  }
+
+  void resize(size_t count, const T &value) {
+    Mutable(true).resize(count, value);
+  }
+
+  void shrink_to_fit() {
+    Mutable(true).shrink_to_fit();
+  }
+
+  /**
+   * drops this object's share of the buffer without copying it.
+   */
+  void clear() {
+    Release();
+  }
+
+  /**
+   * inserts value at index ind.
+   * throw index_out_of_bound if ind > size
+   */
+  void insert(const size_t &ind, const T &value) {
+    Mutable(true).insert(ind, value);
+  }
+
+  /**
+   * removes the element at index ind.
+   * throw index_out_of_bound if ind >= size
+   */
+  void erase(const size_t &ind) {
+    Mutable(true).erase(ind);
+  }
+
+  void push_back(const T &value) {
+    Mutable(true).push_back(value);
+  }
+
+  void push_back(T &&value) {
+    Mutable(true).push_back(std::move(value));
+  }
+
+  template<class... Args>
+  void emplace_back(Args &&...args) {
+    Mutable(true).emplace_back(std::forward<Args>(args)...);
+  }
+
+  /**
+   * throw container_is_empty if size() == 0
+   */
+  void pop_back() {
+    Mutable(true).pop_back();
+  }
+
+private:
+  struct Rep {
+    explicit Rep(const vector_type &data) : refs_(1), shareable_(true), data_(data) {}
+
+    explicit Rep(vector_type &&data) : refs_(1), shareable_(true), data_(std::move(data)) {}
+
+    std::atomic<size_t> refs_;
+    bool shareable_;
+    vector_type data_;
+  };
+
+  static const vector_type &Empty() {
+    static const vector_type empty;
+    return empty;
+  }
+
+  // a reference to the buffer for a new copy: the shared one, or a private copy if it is unshareable.
+  Rep *Share() const {
+    if (rep_ == nullptr) {
+      return nullptr;
+    }
+    if (!rep_->shareable_) {
+      return new Rep(rep_->data_);
+    }
+    rep_->refs_.fetch_add(1, std::memory_order_relaxed);
+    return rep_;
+  }
+
+  void Release() {
+    if (rep_ != nullptr && rep_->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete rep_;
+    }
+    rep_ = nullptr;
+  }
+
+  // make the buffer private to this object, copying it if it is shared, and return it for modification.
+  // unless keep_shareable, a reference into it is about to escape, so it may no longer be shared.
+  vector_type &Mutable(bool keep_shareable) {
+    if (rep_ == nullptr) {
+      rep_ = new Rep(vector_type());
+    } else if (rep_->refs_.load(std::memory_order_acquire) != 1) {
+      Rep *rep = new Rep(rep_->data_);
+      Release();
+      rep_ = rep;
+    }
+    if (!keep_shareable) {
+      rep_->shareable_ = false;
+    }
+    return rep_->data_;
+  }
+
+  Rep *rep_;
+};
+
+}
+
+#endif
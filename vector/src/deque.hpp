@@ -0,0 +1,551 @@
+#ifndef SJTU_DEQUE_HPP
+#define SJTU_DEQUE_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "exceptions.hpp"
+
+namespace sjtu {
+
+/**
+ * a double-ended queue of fixed-size blocks reached through an index array (the map).
+ * push/pop at both ends are amortized O(1) and never move an element: growing only allocates a new block or
+ *   reallocates the map of block pointers, so references and pointers to elements stay valid until the
+ *   element is removed. this suits big element types such as Util::Bint or matrices, which sjtu::vector has
+ *   to relocate on every reallocation.
+ * iterators hold an index, so they are invalidated by push_front / pop_front and stay valid otherwise.
+ * a block holds 4 KiB worth of elements, and at least 16 of them.
+ */
+template<typename T, typename Allocator = std::allocator<T>>
+class deque {
+public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+
+private:
+  template<bool Const>
+  class Iterator {
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+    using iterator_category = std::random_access_iterator_tag;
+
+  private:
+    friend class deque;
+    friend class Iterator<!Const>;
+
+    using Container = std::conditional_t<Const, const deque, deque>;
+
+    Container *deque_ptr_;
+    size_t index_;
+
+    Iterator(Container *deque_ptr, size_t index) : deque_ptr_(deque_ptr), index_(index) {}
+
+  public:
+    Iterator() : deque_ptr_(nullptr), index_(0) {}
+
+    template<bool OtherConst, class = std::enable_if_t<Const && !OtherConst>>
+    Iterator(const Iterator<OtherConst> &other) : deque_ptr_(other.deque_ptr_), index_(other.index_) {}
+
+    Iterator operator+(difference_type n) const {
+      return {deque_ptr_, index_ + n};
+    }
+
+    friend Iterator operator+(difference_type n, const Iterator &it) {
+      return it + n;
+    }
+
+    Iterator operator-(difference_type n) const {
+      return {deque_ptr_, index_ - n};
+    }
+
+    // if these two iterators point to different deques, throw invaild_iterator.
+    difference_type operator-(const Iterator &rhs) const {
+      if (deque_ptr_ != rhs.deque_ptr_) {
+        throw invalid_iterator();
+      }
+      return static_cast<difference_type>(index_ - rhs.index_);
+    }
+
+    Iterator &operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+
+    Iterator &operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator old = *this;
+      ++index_;
+      return old;
+    }
+
+    Iterator &operator++() {
+      ++index_;
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      Iterator old = *this;
+      --index_;
+      return old;
+    }
+
+    Iterator &operator--() {
+      --index_;
+      return *this;
+    }
+
+    reference operator*() const {
+      return deque_ptr_->Element(index_);
+    }
+
+    pointer operator->() const {
+      return &deque_ptr_->Element(index_);
+    }
+
+    reference operator[](difference_type n) const {
+      return deque_ptr_->Element(index_ + n);
+    }
+
+    bool operator==(const Iterator &rhs) const {
+      return deque_ptr_ == rhs.deque_ptr_ && index_ == rhs.index_;
+    }
+
+    bool operator!=(const Iterator &rhs) const {
+      return !(*this == rhs);
+    }
+
+    bool operator<(const Iterator &rhs) const {
+      return index_ < rhs.index_;
+    }
+
+    bool operator>(const Iterator &rhs) const {
+      return index_ > rhs.index_;
+    }
+
+    bool operator<=(const Iterator &rhs) const {
+      return index_ <= rhs.index_;
+    }
+
+    bool operator>=(const Iterator &rhs) const {
+      return index_ >= rhs.index_;
+    }
+  };
+
+public:
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  deque() : deque(Allocator()) {}
+
+  explicit deque(const Allocator &alloc)
+      : alloc_(alloc), map_(nullptr), map_size_(0), map_begin_(0), map_end_(0), first_(0), size_(0) {}
+
+  deque(size_t count, const T &value, const Allocator &alloc = Allocator()) : deque(alloc) {
+    try {
+      for (size_t i = 0; i < count; i++) {
+        push_back(value);
+      }
+    } catch (...) {
+      Free();
+      throw;
+    }
+  }
+
+  deque(const deque &other) : deque(AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+    try {
+      for (size_t i = 0; i < other.size_; i++) {
+        push_back(other.Element(i));
+      }
+    } catch (...) {
+      Free();
+      throw;
+    }
+  }
+
+  deque(deque &&other) noexcept : deque(other.alloc_) {
+    SwapStorage(other);
+  }
+
+  /**
+   * the allocator of other is taken over only if it propagates on copy / move assignment. a move between unequal
+   *   allocators that do not propagate moves the elements one by one.
+   */
+  deque &operator=(const deque &other) {
+    if (this == &other) {
+      return *this;
+    }
+    constexpr bool kPropagate = AllocTraits::propagate_on_container_copy_assignment::value;
+    deque tmp(kPropagate ? other.alloc_ : alloc_);
+    for (size_t i = 0; i < other.size_; i++) {
+      tmp.push_back(other.Element(i));
+    }
+    Free();
+    if constexpr (kPropagate) {
+      alloc_ = other.alloc_;
+    }
+    SwapStorage(tmp);
+    return *this;
+  }
+
+  deque &operator=(deque &&other) noexcept(AllocTraits::propagate_on_container_move_assignment::value ||
+                                           AllocTraits::is_always_equal::value) {
+    if (this == &other) {
+      return *this;
+    }
+    Free();
+    if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+      alloc_ = other.alloc_;
+      SwapStorage(other);
+    } else if (SameAllocator(other)) {
+      SwapStorage(other);
+    } else {
+      for (size_t i = 0; i < other.size_; i++) {
+        push_back(std::move(other.Element(i)));
+      }
+      other.Free();
+    }
+    return *this;
+  }
+
+  ~deque() {
+    Free();
+  }
+
+  /**
+   * exchanges the contents with other.
+   * no element is touched if the allocator propagates on swap (then the allocators are exchanged too) or the
+   *   allocators are equal; otherwise the elements are moved one by one.
+   */
+  void swap(deque &other) noexcept(AllocTraits::propagate_on_container_swap::value ||
+                                   AllocTraits::is_always_equal::value) {
+    if (this == &other) {
+      return;
+    }
+    if constexpr (AllocTraits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(alloc_, other.alloc_);
+      SwapStorage(other);
+    } else {
+      if (SameAllocator(other)) {
+        SwapStorage(other);
+        return;
+      }
+      deque tmp(std::move(other));
+      other = std::move(*this);
+      *this = std::move(tmp);
+    }
+  }
+
+  friend void swap(deque &lhs, deque &rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+  }
+
+  allocator_type get_allocator() const {
+    return alloc_;
+  }
+
+  /**
+   * access specified element with bounds checking
+   * throw index_out_of_bound if pos is not in [0, size)
+   */
+  T &at(const size_t &pos) {
+    if (pos >= size_) {
+      throw index_out_of_bound();
+    }
+    return Element(pos);
+  }
+
+  const T &at(const size_t &pos) const {
+    if (pos >= size_) {
+      throw index_out_of_bound();
+    }
+    return Element(pos);
+  }
+
+  T &operator[](const size_t &pos) {
+    return at(pos);
+  }
+
+  const T &operator[](const size_t &pos) const {
+    return at(pos);
+  }
+
+  /**
+   * access the first / last element.
+   * throw container_is_empty if size == 0
+   */
+  T &front() {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    return Element(0);
+  }
+
+  const T &front() const {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    return Element(0);
+  }
+
+  T &back() {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    return Element(size_ - 1);
+  }
+
+  const T &back() const {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    return Element(size_ - 1);
+  }
+
+  iterator begin() {
+    return {this, 0};
+  }
+
+  const_iterator begin() const {
+    return {this, 0};
+  }
+
+  const_iterator cbegin() const {
+    return {this, 0};
+  }
+
+  iterator end() {
+    return {this, size_};
+  }
+
+  const_iterator end() const {
+    return {this, size_};
+  }
+
+  const_iterator cend() const {
+    return {this, size_};
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  /**
+   * destroys every element and frees every block.
+   */
+  void clear() {
+    Free();
+  }
+
+  void push_back(const T &value) {
+    emplace_back(value);
+  }
+
+  void push_back(T &&value) {
+    emplace_back(std::move(value));
+  }
+
+  void push_front(const T &value) {
+    emplace_front(value);
+  }
+
+  void push_front(T &&value) {
+    emplace_front(std::move(value));
+  }
+
+  template<class... Args>
+  T &emplace_back(Args &&...args) {
+    if (first_ + size_ == (map_end_ - map_begin_) * kBlockSize) {
+      AddBlockBack();
+    }
+    T *res = &Slot(first_ + size_);
+    AllocTraits::construct(alloc_, res, std::forward<Args>(args)...);
+    size_++;
+    return *res;
+  }
+
+  template<class... Args>
+  T &emplace_front(Args &&...args) {
+    if (first_ == 0) {
+      AddBlockFront();
+    }
+    T *res = &Slot(first_ - 1);
+    AllocTraits::construct(alloc_, res, std::forward<Args>(args)...);
+    first_--;
+    size_++;
+    return *res;
+  }
+
+  /**
+   * remove the last / first element; a block left empty is freed.
+   * throw container_is_empty if size() == 0
+   */
+  void pop_back() {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    AllocTraits::destroy(alloc_, &Slot(first_ + size_ - 1));
+    size_--;
+    if (size_ == 0) {
+      KeepOneBlock();
+      return;
+    }
+    while ((map_end_ - map_begin_ - 1) * kBlockSize >= first_ + size_) {
+      DeallocateBlock(map_[--map_end_]);
+    }
+  }
+
+  void pop_front() {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    AllocTraits::destroy(alloc_, &Slot(first_));
+    first_++;
+    size_--;
+    if (size_ == 0) {
+      KeepOneBlock();
+      return;
+    }
+    while (first_ >= kBlockSize) {
+      DeallocateBlock(map_[map_begin_++]);
+      first_ -= kBlockSize;
+    }
+  }
+
+private:
+  using AllocTraits = std::allocator_traits<Allocator>;
+  using MapAllocator = typename AllocTraits::template rebind_alloc<T *>;
+  using MapTraits = std::allocator_traits<MapAllocator>;
+
+  static const size_t kBlockSize = sizeof(T) * 16 < 4096 ? 4096 / sizeof(T) : 16;
+  static const size_t minMapSize = 8;
+
+  // the slot at position g counted from the start of the first block in use.
+  T &Slot(size_t g) const {
+    return map_[map_begin_ + g / kBlockSize][g % kBlockSize];
+  }
+
+  T &Element(size_t ind) const {
+    return Slot(first_ + ind);
+  }
+
+  T *AllocateBlock() {
+    return AllocTraits::allocate(alloc_, kBlockSize);
+  }
+
+  void DeallocateBlock(T *block) {
+    AllocTraits::deallocate(alloc_, block, kBlockSize);
+  }
+
+  // reallocate the map with room for as many new blocks on each side as there are blocks in use, and center
+  // the blocks in it, so that a run of pushes at either end only reallocates the map O(log n) times.
+  void GrowMap() {
+    size_t used = map_end_ - map_begin_;
+    size_t new_size = 3 * used < minMapSize ? minMapSize : 3 * used;
+    MapAllocator map_alloc(alloc_);
+    T **new_map = MapTraits::allocate(map_alloc, new_size);
+    size_t new_begin = (new_size - used) / 2;
+    for (size_t i = 0; i < used; i++) {
+      new_map[new_begin + i] = map_[map_begin_ + i];
+    }
+    if (map_ != nullptr) {
+      MapTraits::deallocate(map_alloc, map_, map_size_);
+    }
+    map_ = new_map;
+    map_size_ = new_size;
+    map_begin_ = new_begin;
+    map_end_ = new_begin + used;
+  }
+
+  void AddBlockBack() {
+    if (map_end_ == map_size_) {
+      GrowMap();
+    }
+    map_[map_end_] = AllocateBlock();
+    map_end_++;
+  }
+
+  void AddBlockFront() {
+    if (map_begin_ == 0) {
+      GrowMap();
+    }
+    map_[map_begin_ - 1] = AllocateBlock();
+    map_begin_--;
+    first_ += kBlockSize;
+  }
+
+  // once empty, keep a single block and start from its middle so that pushes at either end reuse it.
+  void KeepOneBlock() {
+    while (map_end_ - map_begin_ > 1) {
+      DeallocateBlock(map_[--map_end_]);
+    }
+    first_ = kBlockSize / 2;
+  }
+
+  bool SameAllocator(const deque &other) const {
+    if constexpr (AllocTraits::is_always_equal::value) {
+      return true;
+    } else {
+      return alloc_ == other.alloc_;
+    }
+  }
+
+  // exchange the blocks and the map, leaving the allocators in place.
+  void SwapStorage(deque &other) noexcept {
+    using std::swap;
+    swap(map_, other.map_);
+    swap(map_size_, other.map_size_);
+    swap(map_begin_, other.map_begin_);
+    swap(map_end_, other.map_end_);
+    swap(first_, other.first_);
+    swap(size_, other.size_);
+  }
+
+  void Free() {
+    for (size_t i = 0; i < size_; i++) {
+      AllocTraits::destroy(alloc_, &Element(i));
+    }
+    for (size_t i = map_begin_; i < map_end_; i++) {
+      DeallocateBlock(map_[i]);
+    }
+    if (map_ != nullptr) {
+      MapAllocator map_alloc(alloc_);
+      MapTraits::deallocate(map_alloc, map_, map_size_);
+    }
+    map_ = nullptr;
+    map_size_ = map_begin_ = map_end_ = first_ = size_ = 0;
+  }
+
+  Allocator alloc_;
+  T **map_;
+  size_t map_size_, map_begin_, map_end_;
+  size_t first_, size_;
+};
+
+/**
+ * a deque used only at its back: a vector whose elements never move.
+ */
+template<typename T, typename Allocator = std::allocator<T>>
+using stable_vector = deque<T, Allocator>;
+
+}
+
+#endif
@@ -0,0 +1,428 @@
+#ifndef SJTU_MAPPED_VECTOR_HPP
+#define SJTU_MAPPED_VECTOR_HPP
+
+// Linux only: mremap is a GNU extension.
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "exceptions.hpp"
+
+namespace sjtu {
+
+/**
+ * a vector of trivially copyable records stored in a memory-mapped file.
+ * opening an existing file maps it without reading or converting anything, so startup costs no more than the
+ *   page faults of the records actually touched, and the data may be larger than RAM.
+ * appending extends the file; flush() writes the dirty pages back like msync.
+ * the file starts with a 64-byte header (magic, record size, element count) followed by the raw records;
+ *   the records beyond size() up to capacity() are preallocated file space.
+ * a read-only mapped_vector maps the file without write access, so a stray write through a pointer faults.
+ *   its elements are read through a const reference; the non-const accessors (at, operator[], begin, end,
+ *   data) and the operations changing its size throw runtime_error.
+ * iterators, pointers and references are invalidated whenever the file grows or shrinks.
+ * a moved-from mapped_vector holds no file: it is empty and may only be destroyed or assigned to.
+ * throw runtime_error when the file cannot be opened or mapped, or has a different format.
+ */
+template<typename T>
+class mapped_vector {
+  static_assert(std::is_trivially_copyable<T>::value, "mapped_vector only stores trivially copyable types");
+  static_assert(alignof(T) <= 64, "the records must fit the alignment of the data section");
+
+public:
+  enum open_mode {
+    kReadOnly,   // the file must exist and is never modified
+    kReadWrite,  // the file is created if it does not exist
+    kTruncate    // the file is created or emptied
+  };
+
+  using value_type = T;
+  using iterator = T *;
+  using const_iterator = const T *;
+
+  mapped_vector(const char *path, open_mode mode = kReadWrite)
+      : fd_(-1), header_(nullptr), first_(nullptr), capacity_(0), read_only_(mode == kReadOnly) {
+    int flags = (read_only_ ? O_RDONLY : O_RDWR | O_CREAT) | (mode == kTruncate ? O_TRUNC : 0);
+    fd_ = open(path, flags, 0644);
+    if (fd_ < 0) {
+      throw runtime_error();
+    }
+    struct stat st;
+    if (fstat(fd_, &st) != 0) {
+      close(fd_);
+      throw runtime_error();
+    }
+    try {
+      if (st.st_size == 0) {
+        if (read_only_) {
+          throw runtime_error();
+        }
+        Remap(minCapacity);
+        std::memcpy(header_->magic_, kMagic, sizeof(header_->magic_));
+        header_->record_size_ = sizeof(T);
+        header_->size_ = 0;
+      } else {
+        if (static_cast<size_t>(st.st_size) < kDataOffset) {
+          throw runtime_error();
+        }
+        MapExisting((static_cast<size_t>(st.st_size) - kDataOffset) / sizeof(T));
+        if (std::memcmp(header_->magic_, kMagic, sizeof(header_->magic_)) != 0 || header_->record_size_ != sizeof(T) ||
+            header_->size_ > capacity_) {
+          throw runtime_error();
+        }
+      }
+    } catch (...) {
+      Unmap();
+      close(fd_);
+      throw;
+    }
+  }
+
+  mapped_vector(const mapped_vector &other) = delete;
+
+  mapped_vector &operator=(const mapped_vector &other) = delete;
+
+  mapped_vector(mapped_vector &&other) noexcept
+      : fd_(other.fd_), header_(other.header_), first_(other.first_), capacity_(other.capacity_),
+        read_only_(other.read_only_) {
+    other.fd_ = -1;
+    other.header_ = nullptr;
+    other.first_ = nullptr;
+    other.capacity_ = 0;
+  }
+
+  /**
+   * takes over the file of other; the file held before is unmapped and closed as by the destructor.
+   */
+  mapped_vector &operator=(mapped_vector &&other) noexcept {
+    mapped_vector tmp(std::move(other));
+    swap(tmp);
+    return *this;
+  }
+
+  void swap(mapped_vector &other) noexcept {
+    std::swap(fd_, other.fd_);
+    std::swap(header_, other.header_);
+    std::swap(first_, other.first_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(read_only_, other.read_only_);
+  }
+
+  friend void swap(mapped_vector &lhs, mapped_vector &rhs) noexcept {
+    lhs.swap(rhs);
+  }
+
+  /**
+   * unmaps and closes the file. the contents are kept, but are only guaranteed to be on disk after flush().
+   */
+  ~mapped_vector() {
+    if (fd_ < 0) {
+      return;
+    }
+    Unmap();
+    close(fd_);
+  }
+
+  /**
+   * access specified element with bounds checking
+   * throw index_out_of_bound if pos is not in [0, size)
+   */
+  T &at(const size_t &pos) {
+    CheckWritable();
+    if (pos >= size()) {
+      throw index_out_of_bound();
+    }
+    return first_[pos];
+  }
+
+  const T &at(const size_t &pos) const {
+    if (pos >= size()) {
+      throw index_out_of_bound();
+    }
+    return first_[pos];
+  }
+
+  T &operator[](const size_t &pos) {
+    return at(pos);
+  }
+
+  const T &operator[](const size_t &pos) const {
+    return at(pos);
+  }
+
+  /**
+   * access the first / last element.
+   * throw container_is_empty if size == 0
+   */
+  const T &front() const {
+    if (size() == 0) {
+      throw container_is_empty();
+    }
+    return first_[0];
+  }
+
+  const T &back() const {
+    if (size() == 0) {
+      throw container_is_empty();
+    }
+    return first_[size() - 1];
+  }
+
+  iterator begin() {
+    CheckWritable();
+    return first_;
+  }
+
+  const_iterator begin() const {
+    return first_;
+  }
+
+  const_iterator cbegin() const {
+    return first_;
+  }
+
+  iterator end() {
+    CheckWritable();
+    return first_ + size();
+  }
+
+  const_iterator end() const {
+    return first_ + size();
+  }
+
+  const_iterator cend() const {
+    return first_ + size();
+  }
+
+  T *data() {
+    CheckWritable();
+    return first_;
+  }
+
+  const T *data() const {
+    return first_;
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  size_t size() const {
+    return header_ == nullptr ? 0 : header_->size_;
+  }
+
+  size_t capacity() const {
+    return header_ == nullptr ? 0 : capacity_;
+  }
+
+  bool read_only() const {
+    return read_only_;
+  }
+
+  /**
+   * extends the file so that it holds at least new_cap records.
+   */
+  void reserve(size_t new_cap) {
+    CheckWritable();
+    if (new_cap > capacity_) {
+      Remap(new_cap);
+    }
+  }
+
+  /**
+   * resizes to count records; new records are copies of value (zero bytes by default).
+   */
+  void resize(size_t count, const T &value = T()) {
+    CheckWritable();
+    T copy(value);
+    if (count > capacity_) {
+      Remap(Grow(count));
+    }
+    for (size_t i = size(); i < count; i++) {
+      first_[i] = copy;
+    }
+    header_->size_ = count;
+  }
+
+  /**
+   * shrinks the file to hold exactly size() records.
+   */
+  void shrink_to_fit() {
+    CheckWritable();
+    if (capacity_ > size()) {
+      Remap(size());
+    }
+  }
+
+  void clear() {
+    CheckWritable();
+    header_->size_ = 0;
+  }
+
+  /**
+   * inserts value at index ind / before pos, shifting the tail with one memmove.
+   * throw index_out_of_bound if ind > size
+   */
+  iterator insert(const size_t &ind, const T &value) {
+    CheckWritable();
+    size_t n = size();
+    if (ind > n) {
+      throw index_out_of_bound();
+    }
+    T copy(value);
+    if (n == capacity_) {
+      Remap(Grow(n + 1));
+    }
+    std::memmove(first_ + ind + 1, first_ + ind, (n - ind) * sizeof(T));
+    first_[ind] = copy;
+    header_->size_ = n + 1;
+    return first_ + ind;
+  }
+
+  template<class It, class = std::enable_if_t<std::is_convertible<It, const_iterator>::value &&
+                                              !std::is_integral<It>::value>>
+  iterator insert(It pos, const T &value) {
+    return insert(static_cast<size_t>(pos - first_), value);
+  }
+
+  /**
+   * removes the element at index ind / at pos.
+   * throw index_out_of_bound if ind >= size
+   */
+  iterator erase(const size_t &ind) {
+    CheckWritable();
+    size_t n = size();
+    if (ind >= n) {
+      throw index_out_of_bound();
+    }
+    std::memmove(first_ + ind, first_ + ind + 1, (n - ind - 1) * sizeof(T));
+    header_->size_ = n - 1;
+    return first_ + ind;
+  }
+
+  template<class It, class = std::enable_if_t<std::is_convertible<It, const_iterator>::value &&
+                                              !std::is_integral<It>::value>>
+  iterator erase(It pos) {
+    return erase(static_cast<size_t>(pos - first_));
+  }
+
+  /**
+   * appends value, extending the file if it is full.
+   */
+  void push_back(const T &value) {
+    CheckWritable();
+    size_t n = size();
+    T copy(value);
+    if (n == capacity_) {
+      Remap(Grow(n + 1));
+    }
+    first_[n] = copy;
+    header_->size_ = n + 1;
+  }
+
+  /**
+   * throw container_is_empty if size() == 0
+   */
+  void pop_back() {
+    CheckWritable();
+    if (size() == 0) {
+      throw container_is_empty();
+    }
+    header_->size_--;
+  }
+
+  /**
+   * writes the modified pages back to the file and waits for the write to finish.
+   */
+  void flush() {
+    if (read_only_ || header_ == nullptr) {
+      return;
+    }
+    if (msync(header_, MappedBytes(capacity_), MS_SYNC) != 0) {
+      throw runtime_error();
+    }
+  }
+
+private:
+  struct Header {
+    char magic_[8];
+    uint64_t record_size_;
+    uint64_t size_;
+  };
+
+  static const size_t minCapacity = 8;
+  static const size_t kDataOffset = 64;
+  static constexpr char kMagic[8] = {'S', 'J', 'T', 'U', 'M', 'V', 'E', 'C'};
+
+  static size_t MappedBytes(size_t capacity) {
+    return kDataOffset + capacity * sizeof(T);
+  }
+
+  size_t Grow(size_t required) const {
+    size_t res = 2 * capacity_;
+    return res < required ? required : res;
+  }
+
+  void CheckWritable() const {
+    if (read_only_) {
+      throw runtime_error();
+    }
+  }
+
+  void MapExisting(size_t capacity) {
+    int prot = (read_only_ ? PROT_READ : PROT_READ | PROT_WRITE);
+    void *res = mmap(nullptr, MappedBytes(capacity), prot, MAP_SHARED, fd_, 0);
+    if (res == MAP_FAILED) {
+      throw runtime_error();
+    }
+    header_ = static_cast<Header *>(res);
+    first_ = reinterpret_cast<T *>(static_cast<char *>(res) + kDataOffset);
+    capacity_ = capacity;
+  }
+
+  // resize the file to hold new_capacity records and map it again.
+  void Remap(size_t new_capacity) {
+    if (ftruncate(fd_, MappedBytes(new_capacity)) != 0) {
+      throw runtime_error();
+    }
+    if (header_ == nullptr) {
+      MapExisting(new_capacity);
+      return;
+    }
+    void *res = mremap(header_, MappedBytes(capacity_), MappedBytes(new_capacity), MREMAP_MAYMOVE);
+    if (res == MAP_FAILED) {
+      throw runtime_error();
+    }
+    header_ = static_cast<Header *>(res);
+    first_ = reinterpret_cast<T *>(static_cast<char *>(res) + kDataOffset);
+    capacity_ = new_capacity;
+  }
+
+  void Unmap() {
+    if (header_ != nullptr) {
+      munmap(header_, MappedBytes(capacity_));
+      header_ = nullptr;
+      first_ = nullptr;
+    }
+  }
+
+  int fd_;
+  Header *header_;
+  T *first_;
+  size_t capacity_;
+  bool read_only_;
+};
+
+}
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef SJTU_MMAP_ALLOCATOR_HPP
+#define SJTU_MMAP_ALLOCATOR_HPP
+
+// Linux only: mremap is a GNU extension.
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+
+namespace sjtu {
+
+/**
+ * an allocator for very large vectors.
+ * blocks of at least MmapThreshold bytes are mapped directly with mmap and marked for transparent huge pages
+ *   with madvise(MADV_HUGEPAGE), which cuts TLB misses on big scans. smaller blocks come from std::allocator.
+ * it provides reallocate(), so a vector of trivially relocatable elements grows a mapped buffer with mremap:
+ *   the kernel moves page table entries instead of the vector copying its elements.
+ */
+template<typename T, size_t MmapThreshold = (size_t(1) << 21)>
+class mmap_allocator {
+public:
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  template<typename U>
+  struct rebind {
+    using other = mmap_allocator<U, MmapThreshold>;
+  };
+
+  mmap_allocator() = default;
+
+  template<typename U>
+  mmap_allocator(const mmap_allocator<U, MmapThreshold> &) {}
+
+  T *allocate(size_t n) {
+    size_t bytes = n * sizeof(T);
+    if (bytes < MmapThreshold) {
+      return std::allocator<T>().allocate(n);
+    }
+    void *res = mmap(nullptr, MappedSize(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (res == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    AdviseHugePages(res, MappedSize(bytes));
+    return static_cast<T *>(res);
+  }
+
+  void deallocate(T *p, size_t n) {
+    size_t bytes = n * sizeof(T);
+    if (bytes < MmapThreshold) {
+      std::allocator<T>().deallocate(p, n);
+      return;
+    }
+    munmap(p, MappedSize(bytes));
+  }
+
+  /**
+   * resizes the block p of old_n elements to new_n elements, keeping the first min(old_n, new_n) elements
+   *   bytewise. returns the (possibly moved) block.
+   * a mapped block stays mapped and is resized with mremap; other blocks are copied.
+   */
+  T *reallocate(T *p, size_t old_n, size_t new_n) {
+    size_t old_bytes = old_n * sizeof(T), new_bytes = new_n * sizeof(T);
+    if (old_bytes >= MmapThreshold && new_bytes >= MmapThreshold) {
+      void *res = mremap(p, MappedSize(old_bytes), MappedSize(new_bytes), MREMAP_MAYMOVE);
+      if (res == MAP_FAILED) {
+        throw std::bad_alloc();
+      }
+      AdviseHugePages(res, MappedSize(new_bytes));
+      return static_cast<T *>(res);
+    }
+    T *res = allocate(new_n);
+    std::memcpy(static_cast<void *>(res), static_cast<const void *>(p), old_bytes < new_bytes ? old_bytes : new_bytes);
+    deallocate(p, old_n);
+    return res;
+  }
+
+  template<typename U>
+  bool operator==(const mmap_allocator<U, MmapThreshold> &) const {
+    return true;
+  }
+
+  template<typename U>
+  bool operator!=(const mmap_allocator<U, MmapThreshold> &) const {
+    return false;
+  }
+
+private:
+  static size_t MappedSize(size_t bytes) {
+    static const size_t page_size = sysconf(_SC_PAGESIZE);
+    return (bytes + page_size - 1) / page_size * page_size;
+  }
+
+  static void AdviseHugePages(void *p, size_t bytes) {
+#ifdef MADV_HUGEPAGE
+    // only a hint: failure (e.g. THP disabled) leaves the mapping on normal pages.
+    madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+  }
+};
+
+}
+
+#endif
@@ -0,0 +1,344 @@
+#ifndef SJTU_PARALLEL_HPP
+#define SJTU_PARALLEL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include "vector.hpp"
+
+namespace sjtu {
+namespace par {
+
+/**
+ * a fixed set of worker threads running one job at a time.
+ * a job is split into numbered tasks; every thread, including the caller, repeatedly claims the next unclaimed
+ *   task from a shared atomic counter, so a thread that finishes early keeps taking work from the slow ones.
+ * a job submitted from inside a task runs serially on the calling thread.
+ */
+class thread_pool {
+public:
+  explicit thread_pool(size_t threads = std::thread::hardware_concurrency())
+      : task_(nullptr), n_tasks_(0), next_(0), done_(0), active_(0), generation_(0), stop_(false) {
+    for (size_t i = 1; i < threads; i++) {
+      workers_.emplace_back([this] { WorkerLoop(); });
+    }
+  }
+
+  thread_pool(const thread_pool &other) = delete;
+
+  thread_pool &operator=(const thread_pool &other) = delete;
+
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (size_t i = 0; i < workers_.size(); i++) {
+      workers_[i].join();
+    }
+  }
+
+  /**
+   * returns the number of threads working on a job, the caller included.
+   */
+  size_t size() const {
+    return workers_.size() + 1;
+  }
+
+  /**
+   * calls f(i) for every i in [0, n_tasks) and waits for all of them.
+   * if some calls throw, the first exception is rethrown after the job is finished.
+   */
+  template<class F>
+  void run(size_t n_tasks, F &&f) {
+    if (n_tasks == 0) {
+      return;
+    }
+    if (InsideTask() || workers_.empty() || n_tasks == 1) {
+      for (size_t i = 0; i < n_tasks; i++) {
+        f(i);
+      }
+      return;
+    }
+    std::function<void(size_t)> task(std::ref(f));
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      task_ = &task;
+      n_tasks_ = n_tasks;
+      next_ = 0;
+      done_ = 0;
+      error_ = nullptr;
+      generation_++;
+    }
+    wake_.notify_all();
+    Work(task, n_tasks);
+    // clearing task_ in the same critical section as the check of active_ closes the job: no worker can join it
+    // any more, so the next run() may reset the shared state.
+    std::unique_lock<std::mutex> lock(mutex_);
+    finished_.wait(lock, [this] { return done_ == n_tasks_ && active_ == 0; });
+    task_ = nullptr;
+    if (error_ != nullptr) {
+      std::rethrow_exception(error_);
+    }
+  }
+
+  /**
+   * the pool shared by the sjtu::par algorithms, with one thread per hardware thread.
+   */
+  static thread_pool &instance() {
+    static thread_pool pool;
+    return pool;
+  }
+
+private:
+  static bool &InsideTask() {
+    thread_local bool inside = false;
+    return inside;
+  }
+
+  void WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    unsigned long long seen = 0;
+    while (true) {
+      wake_.wait(lock, [this, seen] { return stop_ || generation_ != seen; });
+      if (stop_) {
+        return;
+      }
+      seen = generation_;
+      // a worker waking up after the job is finished skips it, as the next job may be setting up already.
+      if (task_ == nullptr) {
+        continue;
+      }
+      const std::function<void(size_t)> &task = *task_;
+      size_t n_tasks = n_tasks_;
+      active_++;
+      lock.unlock();
+      Work(task, n_tasks);
+      lock.lock();
+      active_--;
+      if (active_ == 0) {
+        finished_.notify_all();
+      }
+    }
+  }
+
+  // claim and run tasks of the current job until none is left. task and n_tasks are read under mutex_ by the
+  // caller.
+  void Work(const std::function<void(size_t)> &task, size_t n_tasks) {
+    InsideTask() = true;
+    for (size_t i = next_++; i < n_tasks; i = next_++) {
+      try {
+        task(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error_ == nullptr) {
+          error_ = std::current_exception();
+        }
+      }
+      if (++done_ == n_tasks) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_.notify_all();
+      }
+    }
+    InsideTask() = false;
+  }
+
+  vector<std::thread> workers_;
+  std::mutex run_mutex_, mutex_;
+  std::condition_variable wake_, finished_;
+  const std::function<void(size_t)> *task_;
+  size_t n_tasks_;
+  std::atomic<size_t> next_, done_;
+  size_t active_;
+  unsigned long long generation_;
+  bool stop_;
+  std::exception_ptr error_;
+};
+
+/**
+ * the number of elements below which a chunk is not split further.
+ */
+const size_t kGrainSize = 4096;
+
+// split [0, n) into chunks, a few per thread so that the dynamic claiming can balance the load, and call
+// body(chunk_index, begin, end) for each of them on the pool.
+template<class Body>
+size_t ForChunks(thread_pool &pool, size_t n, Body body) {
+  size_t chunks = (n + kGrainSize - 1) / kGrainSize;
+  if (chunks > pool.size() * 8) {
+    chunks = pool.size() * 8;
+  }
+  if (chunks == 0) {
+    return 0;
+  }
+  size_t chunk_size = (n + chunks - 1) / chunks;
+  chunks = (n + chunk_size - 1) / chunk_size;
+  pool.run(chunks, [&](size_t c) {
+    size_t begin = c * chunk_size, end = begin + chunk_size < n ? begin + chunk_size : n;
+    body(c, begin, end);
+  });
+  return chunks;
+}
+
+// the result of one chunk. wrapping T keeps vector<bool> from packing the results of different chunks, which
+// are written from different threads, into a shared word.
+template<class T>
+struct ChunkResult {
+  T value;
+};
+
+/**
+ * the algorithms below work on random access ranges, e.g. those of sjtu::vector, and run on
+ *   thread_pool::instance() unless another pool is given.
+ * the functions they are given are called concurrently and in no particular order.
+ * an output range must not be a packed vector<bool>, whose neighbouring elements share a word.
+ */
+
+/**
+ * calls f(x) for every x in [first, last).
+ */
+template<class RandomIt, class F>
+void for_each(RandomIt first, RandomIt last, F f, thread_pool &pool = thread_pool::instance()) {
+  ForChunks(pool, last - first, [&](size_t, size_t begin, size_t end) {
+    for (RandomIt it = first + begin, stop = first + end; it != stop; ++it) {
+      f(*it);
+    }
+  });
+}
+
+/**
+ * writes op(x) for every x in [first, last) to the range starting at d_first.
+ * returns the end of the written range.
+ */
+template<class RandomIt, class OutputIt, class UnaryOp>
+OutputIt transform(RandomIt first, RandomIt last, OutputIt d_first, UnaryOp op,
+                   thread_pool &pool = thread_pool::instance()) {
+  size_t n = last - first;
+  ForChunks(pool, n, [&](size_t, size_t begin, size_t end) {
+    OutputIt out = d_first + begin;
+    for (RandomIt it = first + begin, stop = first + end; it != stop; ++it, ++out) {
+      *out = op(*it);
+    }
+  });
+  return d_first + n;
+}
+
+/**
+ * folds [first, last) and init with op, which must be associative.
+ * the chunks are folded separately and their results combined in order, so op need not be commutative.
+ */
+template<class RandomIt, class T, class BinaryOp = std::plus<>>
+T reduce(RandomIt first, RandomIt last, T init, BinaryOp op = BinaryOp(),
+         thread_pool &pool = thread_pool::instance()) {
+  size_t n = last - first;
+  vector<ChunkResult<T>> partial(pool.size() * 8, ChunkResult<T>{init});
+  size_t chunks = ForChunks(pool, n, [&](size_t c, size_t begin, size_t end) {
+    T acc = first[begin];
+    for (size_t i = begin + 1; i < end; i++) {
+      acc = op(acc, first[i]);
+    }
+    partial[c].value = acc;
+  });
+  for (size_t c = 0; c < chunks; c++) {
+    init = op(init, partial[c].value);
+  }
+  return init;
+}
+
+/**
+ * writes the inclusive prefix folds of [first, last) with op, which must be associative, starting at d_first.
+ * each chunk is folded once to find its offset and then scanned from that offset; a range that fits in one
+ *   chunk, or a pool of one thread, is scanned in a single pass instead.
+ * returns the end of the written range.
+ */
+template<class RandomIt, class OutputIt, class BinaryOp = std::plus<>>
+OutputIt inclusive_scan(RandomIt first, RandomIt last, OutputIt d_first, BinaryOp op = BinaryOp(),
+                        thread_pool &pool = thread_pool::instance()) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  size_t n = last - first;
+  if (n == 0) {
+    return d_first;
+  }
+  if (pool.size() == 1 || n <= kGrainSize) {
+    // one chunk has no offset to wait for, so a single pass does; the two passes below read the input twice.
+    T acc = first[0];
+    d_first[0] = acc;
+    for (size_t i = 1; i < n; i++) {
+      acc = op(acc, first[i]);
+      d_first[i] = acc;
+    }
+    return d_first + n;
+  }
+  vector<ChunkResult<T>> sums(pool.size() * 8, ChunkResult<T>{first[0]});
+  size_t chunks = ForChunks(pool, n, [&](size_t c, size_t begin, size_t end) {
+    T acc = first[begin];
+    for (size_t i = begin + 1; i < end; i++) {
+      acc = op(acc, first[i]);
+    }
+    sums[c].value = acc;
+  });
+  // sums[c] becomes the fold of every chunk up to c.
+  for (size_t c = 1; c < chunks; c++) {
+    sums[c].value = op(sums[c - 1].value, sums[c].value);
+  }
+  ForChunks(pool, n, [&](size_t c, size_t begin, size_t end) {
+    T acc = (c == 0 ? first[begin] : op(sums[c - 1].value, first[begin]));
+    d_first[begin] = acc;
+    for (size_t i = begin + 1; i < end; i++) {
+      acc = op(acc, first[i]);
+      d_first[i] = acc;
+    }
+  });
+  return d_first + n;
+}
+
+/**
+ * returns the number of elements x in [first, last) with pred(x).
+ */
+template<class RandomIt, class Pred>
+size_t count_if(RandomIt first, RandomIt last, Pred pred, thread_pool &pool = thread_pool::instance()) {
+  std::atomic<size_t> res(0);
+  ForChunks(pool, last - first, [&](size_t, size_t begin, size_t end) {
+    size_t count = 0;
+    for (size_t i = begin; i < end; i++) {
+      if (pred(first[i])) {
+        count++;
+      }
+    }
+    res += count;
+  });
+  return res;
+}
+
+/**
+ * returns the first iterator it in [first, last) with pred(*it), or last.
+ * chunks are claimed in order and a chunk after the best match found so far is skipped,
+ *   so the search stops soon after the first match.
+ */
+template<class RandomIt, class Pred>
+RandomIt find_if(RandomIt first, RandomIt last, Pred pred, thread_pool &pool = thread_pool::instance()) {
+  size_t n = last - first;
+  std::atomic<size_t> best(n);
+  ForChunks(pool, n, [&](size_t, size_t begin, size_t end) {
+    for (size_t i = begin; i < end && i < best.load(std::memory_order_relaxed); i++) {
+      if (pred(first[i])) {
+        size_t cur = best.load();
+        while (i < cur && !best.compare_exchange_weak(cur, i)) {}
+        return;
+      }
+    }
+  });
+  return first + best.load();
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,415 @@
+#ifndef SJTU_SIMD_HPP
+#define SJTU_SIMD_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+namespace sjtu {
+namespace simd {
+
+/**
+ * bulk kernels over arrays of int, long long, float and double, written once with GCC vector extensions
+ *   and compiled for several instruction sets; each call runs the widest one the CPU supports (AVX-512,
+ *   AVX2, SSE4.2, or the baseline, which is SSE2 on x86-64 and plain code elsewhere).
+ * every kernel has an overload taking an sjtu::vector and one taking a pointer and a length.
+ * sum and dot accumulate in several lanes at once, so for float and double they add in a different order than
+ *   a scalar loop and may differ from it in the last bits. integers are summed as long long.
+ * min_element / max_element return the index of the first smallest / largest element; with NaNs among
+ *   floating-point elements the result is unspecified.
+ */
+enum class isa { kBaseline, kSse42, kAvx2, kAvx512 };
+
+// whether the kernels are available for T.
+template<class T>
+constexpr bool kSupported = std::is_same<T, int>::value || std::is_same<T, long long>::value ||
+                            std::is_same<T, float>::value || std::is_same<T, double>::value;
+
+// the type of sum and dot over T.
+template<class T>
+using sum_type = std::conditional_t<std::is_integral<T>::value, long long, T>;
+
+/**
+ * returns the widest instruction set supported by the CPU.
+ */
+inline isa detected_isa() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  static const isa detected = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+        __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl")) {
+      return isa::kAvx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+      return isa::kAvx2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+      return isa::kSse42;
+    }
+    return isa::kBaseline;
+  }();
+  return detected;
+#else
+  return isa::kBaseline;
+#endif
+}
+
+inline std::atomic<int> &IsaLimit() {
+  static std::atomic<int> limit(static_cast<int>(isa::kAvx512));
+  return limit;
+}
+
+/**
+ * caps the instruction set used by later calls, e.g. to compare against the baseline. the default is no cap.
+ */
+inline void set_isa_limit(isa limit) {
+  IsaLimit().store(static_cast<int>(limit), std::memory_order_relaxed);
+}
+
+/**
+ * returns the instruction set the kernels currently run with.
+ */
+inline isa active_isa() {
+  int detected = static_cast<int>(detected_isa()), limit = IsaLimit().load(std::memory_order_relaxed);
+  return static_cast<isa>(detected < limit ? detected : limit);
+}
+
+#define SJTU_SIMD_INLINE inline __attribute__((always_inline))
+
+// the kernels on vectors of Bytes bytes. they are always inlined into the per-isa wrappers below, so that the
+// vector operations are compiled with the wrapper's instruction set. vectors never cross a call boundary.
+template<class T, size_t Bytes>
+struct Kernels {
+  typedef T Vec __attribute__((vector_size(Bytes)));
+  // sum and dot widen int to long long; they load Part vectors of T that widen to one native vector, as a
+  // vector twice the native width compiles poorly.
+  typedef sum_type<T> Acc __attribute__((vector_size(Bytes)));
+  typedef T Part __attribute__((vector_size(Bytes / sizeof(sum_type<T>) * sizeof(T))));
+  typedef std::conditional_t<sizeof(T) == 4, int32_t, int64_t> Lane;
+  typedef Lane Mask __attribute__((vector_size(Bytes)));
+
+  static const size_t kLanes = Bytes / sizeof(T);
+  static const size_t kAccLanes = Bytes / sizeof(sum_type<T>);
+
+  template<class V>
+  static SJTU_SIMD_INLINE void Load(V &v, const T *p) {
+    __builtin_memcpy(&v, p, sizeof(V));
+  }
+
+  static SJTU_SIMD_INLINE bool Any(const Mask &m) {
+    Lane res = 0;
+    for (size_t i = 0; i < kLanes; i++) {
+      res |= m[i];
+    }
+    return res != 0;
+  }
+
+  static SJTU_SIMD_INLINE void Fill(T *p, size_t n, T value) {
+    Vec s = Vec{} + value;
+    size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+      __builtin_memcpy(p + i, &s, Bytes);
+    }
+    for (; i < n; i++) {
+      p[i] = value;
+    }
+  }
+
+  static SJTU_SIMD_INLINE size_t Find(const T *p, size_t n, T value) {
+    Vec s = Vec{} + value, a, b, c, d;
+    size_t i = 0;
+    // test four vectors at a time; the scalar loop then locates the match inside the block.
+    for (; i + 4 * kLanes <= n; i += 4 * kLanes) {
+      Load(a, p + i);
+      Load(b, p + i + kLanes);
+      Load(c, p + i + 2 * kLanes);
+      Load(d, p + i + 3 * kLanes);
+      if (Any(a == s) || Any(b == s) || Any(c == s) || Any(d == s)) {
+        break;
+      }
+    }
+    for (; i < n; i++) {
+      if (p[i] == value) {
+        return i;
+      }
+    }
+    return n;
+  }
+
+  static SJTU_SIMD_INLINE size_t Count(const T *p, size_t n, T value) {
+    Vec s = Vec{} + value, x;
+    size_t res = 0, i = 0;
+    // each lane of acc counts down by one per match; it is flushed before it could overflow.
+    while (i + kLanes <= n) {
+      Mask acc = Mask{};
+      for (size_t block = 0; block < (size_t(1) << 24) && i + kLanes <= n; block++, i += kLanes) {
+        Load(x, p + i);
+        acc += (x == s);
+      }
+      for (size_t j = 0; j < kLanes; j++) {
+        res -= acc[j];
+      }
+    }
+    for (; i < n; i++) {
+      res += (p[i] == value);
+    }
+    return res;
+  }
+
+  template<bool Min>
+  static SJTU_SIMD_INLINE size_t Extreme(const T *p, size_t n) {
+    if (n == 0) {
+      return 0;
+    }
+    T best = p[0];
+    size_t i = 0;
+    if (n >= kLanes) {
+      Vec m, x;
+      Load(m, p);
+      for (i = kLanes; i + kLanes <= n; i += kLanes) {
+        Load(x, p + i);
+        m = (Min ? x < m : x > m) ? x : m;
+      }
+      for (size_t j = 0; j < kLanes; j++) {
+        if (Min ? m[j] < best : m[j] > best) {
+          best = m[j];
+        }
+      }
+    }
+    for (; i < n; i++) {
+      if (Min ? p[i] < best : p[i] > best) {
+        best = p[i];
+      }
+    }
+    return Find(p, n, best);
+  }
+
+  static SJTU_SIMD_INLINE sum_type<T> Sum(const T *p, size_t n) {
+    Acc acc0 = Acc{}, acc1 = Acc{};
+    Part x, y;
+    size_t i = 0;
+    for (; i + 2 * kAccLanes <= n; i += 2 * kAccLanes) {
+      Load(x, p + i);
+      Load(y, p + i + kAccLanes);
+      acc0 += __builtin_convertvector(x, Acc);
+      acc1 += __builtin_convertvector(y, Acc);
+    }
+    acc0 += acc1;
+    sum_type<T> res = 0;
+    for (size_t j = 0; j < kAccLanes; j++) {
+      res += acc0[j];
+    }
+    for (; i < n; i++) {
+      res += p[i];
+    }
+    return res;
+  }
+
+  static SJTU_SIMD_INLINE sum_type<T> Dot(const T *p, const T *q, size_t n) {
+    constexpr bool kWiden = sizeof(sum_type<T>) == 2 * sizeof(T) && std::is_integral<T>::value;
+    Acc acc0 = Acc{}, acc1 = Acc{};
+    Part x, y;
+    size_t i = 0;
+    // 16-byte targets lack the 64-bit arithmetic shift below, and the scalar multiply beats its emulation.
+    for (; !(kWiden && Bytes == 16) && i + 2 * kAccLanes <= n; i += 2 * kAccLanes) {
+      if constexpr (kWiden) {
+        // a full vector of T viewed as Acc holds an even lane in each low half and an odd lane in each high
+        // half; sign-extending them in place lets the multiply map to pmuldq instead of a 64-bit emulation
+        Acc a, b;
+        Load(a, p + i);
+        Load(b, q + i);
+        acc0 += ((a << 32) >> 32) * ((b << 32) >> 32);
+        acc1 += (a >> 32) * (b >> 32);
+      } else {
+        Load(x, p + i);
+        Load(y, q + i);
+        acc0 += __builtin_convertvector(x, Acc) * __builtin_convertvector(y, Acc);
+        Load(x, p + i + kAccLanes);
+        Load(y, q + i + kAccLanes);
+        acc1 += __builtin_convertvector(x, Acc) * __builtin_convertvector(y, Acc);
+      }
+    }
+    acc0 += acc1;
+    sum_type<T> res = 0;
+    for (size_t j = 0; j < kAccLanes; j++) {
+      res += acc0[j];
+    }
+    for (; i < n; i++) {
+      res += static_cast<sum_type<T>>(p[i]) * q[i];
+    }
+    return res;
+  }
+};
+
+// one entry point per kernel compiled for an instruction set, Bytes being its vector width.
+#define SJTU_SIMD_TARGET(Name, Attribute, Bytes)                                                                  \
+  struct Name {                                                                                                   \
+    template<class T>                                                                                             \
+    Attribute static void Fill(T *p, size_t n, T value) {                                                        \
+      Kernels<T, Bytes>::Fill(p, n, value);                                                                       \
+    }                                                                                                             \
+    template<class T>                                                                                             \
+    Attribute static size_t Find(const T *p, size_t n, T value) {                                                \
+      return Kernels<T, Bytes>::Find(p, n, value);                                                                \
+    }                                                                                                             \
+    template<class T>                                                                                             \
+    Attribute static size_t Count(const T *p, size_t n, T value) {                                               \
+      return Kernels<T, Bytes>::Count(p, n, value);                                                               \
+    }                                                                                                             \
+    template<class T>                                                                                             \
+    Attribute static size_t MinElement(const T *p, size_t n) {                                                   \
+      return Kernels<T, Bytes>::template Extreme<true>(p, n);                                                     \
+    }                                                                                                             \
+    template<class T>                                                                                             \
+    Attribute static size_t MaxElement(const T *p, size_t n) {                                                   \
+      return Kernels<T, Bytes>::template Extreme<false>(p, n);                                                    \
+    }                                                                                                             \
+    template<class T>                                                                                             \
+    Attribute static sum_type<T> Sum(const T *p, size_t n) {                                                     \
+      return Kernels<T, Bytes>::Sum(p, n);                                                                        \
+    }                                                                                                             \
+    template<class T>                                                                                             \
+    Attribute static sum_type<T> Dot(const T *p, const T *q, size_t n) {                                         \
+      return Kernels<T, Bytes>::Dot(p, q, n);                                                                     \
+    }                                                                                                             \
+  };
+
+SJTU_SIMD_TARGET(Baseline, , 16)
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+SJTU_SIMD_TARGET(Sse42, __attribute__((target("sse4.2"))), 16)
+SJTU_SIMD_TARGET(Avx2, __attribute__((target("avx2"))), 32)
+SJTU_SIMD_TARGET(Avx512, __attribute__((target("avx512f,avx512dq,avx512bw,avx512vl"))), 64)
+#endif
+
+#undef SJTU_SIMD_TARGET
+#undef SJTU_SIMD_INLINE
+
+// call fn with the entry points of the active instruction set.
+template<class Fn>
+auto Dispatch(Fn fn) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  switch (active_isa()) {
+    case isa::kAvx512:
+      return fn(Avx512());
+    case isa::kAvx2:
+      return fn(Avx2());
+    case isa::kSse42:
+      return fn(Sse42());
+    default:
+      break;
+  }
+#endif
+  return fn(Baseline());
+}
+
+/**
+ * sets the n elements at first to value.
+ */
+template<class T>
+void fill(T *first, size_t n, T value) {
+  static_assert(kSupported<T>, "simd kernels support int, long long, float and double");
+  Dispatch([&](auto target) { decltype(target)::Fill(first, n, value); });
+}
+
+/**
+ * returns the index of the first element equal to value, or n if there is none.
+ */
+template<class T>
+size_t find(const T *first, size_t n, T value) {
+  static_assert(kSupported<T>, "simd kernels support int, long long, float and double");
+  return Dispatch([&](auto target) { return decltype(target)::Find(first, n, value); });
+}
+
+/**
+ * returns the number of elements equal to value.
+ */
+template<class T>
+size_t count(const T *first, size_t n, T value) {
+  static_assert(kSupported<T>, "simd kernels support int, long long, float and double");
+  return Dispatch([&](auto target) { return decltype(target)::Count(first, n, value); });
+}
+
+/**
+ * return the index of the first smallest / largest element, or 0 if n == 0.
+ */
+template<class T>
+size_t min_element(const T *first, size_t n) {
+  static_assert(kSupported<T>, "simd kernels support int, long long, float and double");
+  return Dispatch([&](auto target) { return decltype(target)::MinElement(first, n); });
+}
+
+template<class T>
+size_t max_element(const T *first, size_t n) {
+  static_assert(kSupported<T>, "simd kernels support int, long long, float and double");
+  return Dispatch([&](auto target) { return decltype(target)::MaxElement(first, n); });
+}
+
+/**
+ * returns the sum of the elements.
+ */
+template<class T>
+sum_type<T> sum(const T *first, size_t n) {
+  static_assert(kSupported<T>, "simd kernels support int, long long, float and double");
+  return Dispatch([&](auto target) { return decltype(target)::Sum(first, n); });
+}
+
+/**
+ * returns the sum of the products of the elements at the same index.
+ */
+template<class T>
+sum_type<T> dot(const T *lhs, const T *rhs, size_t n) {
+  static_assert(kSupported<T>, "simd kernels support int, long long, float and double");
+  return Dispatch([&](auto target) { return decltype(target)::Dot(lhs, rhs, n); });
+}
+
+template<class T, class Allocator, class GrowthPolicy, size_t N>
+void fill(vector<T, Allocator, GrowthPolicy, N> &vec, const T &value) {
+  fill(vec.data(), vec.size(), value);
+}
+
+/**
+ * the vector overloads of find / min_element / max_element return vec.size() when there is no answer.
+ */
+template<class T, class Allocator, class GrowthPolicy, size_t N>
+size_t find(const vector<T, Allocator, GrowthPolicy, N> &vec, const T &value) {
+  return find(vec.data(), vec.size(), value);
+}
+
+template<class T, class Allocator, class GrowthPolicy, size_t N>
+size_t count(const vector<T, Allocator, GrowthPolicy, N> &vec, const T &value) {
+  return count(vec.data(), vec.size(), value);
+}
+
+template<class T, class Allocator, class GrowthPolicy, size_t N>
+size_t min_element(const vector<T, Allocator, GrowthPolicy, N> &vec) {
+  return vec.empty() ? 0 : min_element(vec.data(), vec.size());
+}
+
+template<class T, class Allocator, class GrowthPolicy, size_t N>
+size_t max_element(const vector<T, Allocator, GrowthPolicy, N> &vec) {
+  return vec.empty() ? 0 : max_element(vec.data(), vec.size());
+}
+
+template<class T, class Allocator, class GrowthPolicy, size_t N>
+sum_type<T> sum(const vector<T, Allocator, GrowthPolicy, N> &vec) {
+  return sum(vec.data(), vec.size());
+}
+
+/**
+ * throw runtime_error if the sizes differ
+ */
+template<class T, class Allocator, class GrowthPolicy, size_t N>
+sum_type<T> dot(const vector<T, Allocator, GrowthPolicy, N> &lhs, const vector<T, Allocator, GrowthPolicy, N> &rhs) {
+  if (lhs.size() != rhs.size()) {
+    throw runtime_error();
+  }
+  return dot(lhs.data(), rhs.data(), lhs.size());
+}
+
+}
+}
+
+#endif
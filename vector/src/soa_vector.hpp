@@ -0,0 +1,452 @@
+#ifndef SJTU_SOA_VECTOR_HPP
+#define SJTU_SOA_VECTOR_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+namespace sjtu {
+
+/**
+ * a vector of records (Fields...) stored as a structure of arrays: each field has its own sjtu::vector, so a
+ *   scan over one field reads only that field's bytes and can be vectorized.
+ * column<I>() exposes field I as a contiguous unchecked_view. a row is reached through a proxy holding the
+ *   container and the index; row.get<I>() returns a reference to the field, and a row converts to and can be
+ *   assigned from std::tuple<Fields...>.
+ * a bool field is stored one byte per flag (column_type is unsigned char), since the packed vector<bool> has
+ *   neither element references nor data(): get<I>() returns a proxy convertible to and assignable from bool
+ *   (or the value, for a const row), and column<I>() views the bytes, which are 0 or 1.
+ * push_back / insert change every column, and restore the columns already changed if a later one throws, so
+ *   the columns keep the same size. pop_back / erase change the columns one after another without rollback:
+ *   they throw only if shrinking a column's storage fails or, for erase, a move assignment throws, and then
+ *   may leave the columns with different sizes.
+ */
+template<typename... Fields>
+class soa_vector {
+  static_assert(sizeof...(Fields) > 0, "a soa_vector needs at least one field");
+
+public:
+  using value_type = std::tuple<Fields...>;
+
+  template<size_t I>
+  using field_type = std::tuple_element_t<I, value_type>;
+
+  // the element type of the column of field I.
+  template<size_t I>
+  using column_type = std::conditional_t<std::is_same<field_type<I>, bool>::value, unsigned char, field_type<I>>;
+
+private:
+  // the proxy returned by get<I>() for a bool field of a mutable row.
+  class BoolReference {
+  public:
+    explicit BoolReference(unsigned char *byte) : byte_(byte) {}
+
+    BoolReference(const BoolReference &other) = default;
+
+    operator bool() const {
+      return *byte_ != 0;
+    }
+
+    const BoolReference &operator=(bool value) const {
+      *byte_ = value;
+      return *this;
+    }
+
+    const BoolReference &operator=(const BoolReference &other) const {
+      return *this = static_cast<bool>(other);
+    }
+
+  private:
+    unsigned char *byte_;
+  };
+
+  template<size_t I, bool Const>
+  using FieldReference = std::conditional_t<std::is_same<field_type<I>, bool>::value,
+                                            std::conditional_t<Const, bool, BoolReference>,
+                                            std::conditional_t<Const, const field_type<I> &, field_type<I> &>>;
+
+  template<bool Const>
+  class RowReference {
+  public:
+    template<size_t I>
+    FieldReference<I, Const> get() const {
+      if constexpr (std::is_same<field_type<I>, bool>::value && !Const) {
+        return BoolReference(&std::get<I>(soa_ptr_->columns_)[index_]);
+      } else {
+        return std::get<I>(soa_ptr_->columns_)[index_];
+      }
+    }
+
+    operator value_type() const {
+      return soa_ptr_->Row(index_, std::index_sequence_for<Fields...>());
+    }
+
+    template<bool C = Const, class = std::enable_if_t<!C>>
+    const RowReference &operator=(const value_type &value) const {
+      Assign(value, std::index_sequence_for<Fields...>());
+      return *this;
+    }
+
+    // assigning a row copies the fields, like assigning the record it stands for.
+    const RowReference &operator=(const RowReference &other) const {
+      static_assert(!Const, "a const row cannot be assigned to");
+      return *this = static_cast<value_type>(other);
+    }
+
+    template<bool C = Const, class = std::enable_if_t<!C>>
+    const RowReference &operator=(const RowReference<true> &other) const {
+      return *this = static_cast<value_type>(other);
+    }
+
+    RowReference(const RowReference &other) = default;
+
+  private:
+    friend class soa_vector;
+
+    using Container = std::conditional_t<Const, const soa_vector, soa_vector>;
+
+    RowReference(Container *soa_ptr, size_t index) : soa_ptr_(soa_ptr), index_(index) {}
+
+    template<size_t... I>
+    void Assign(const value_type &value, std::index_sequence<I...>) const {
+      ((std::get<I>(soa_ptr_->columns_)[index_] = std::get<I>(value)), ...);
+    }
+
+    Container *soa_ptr_;
+    size_t index_;
+  };
+
+  template<bool Const>
+  class Iterator {
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = soa_vector::value_type;
+    using reference = RowReference<Const>;
+    using pointer = void;
+    using iterator_category = std::random_access_iterator_tag;
+
+  private:
+    friend class soa_vector;
+    friend class Iterator<!Const>;
+
+    using Container = std::conditional_t<Const, const soa_vector, soa_vector>;
+
+    Container *soa_ptr_;
+    size_t index_;
+
+    Iterator(Container *soa_ptr, size_t index) : soa_ptr_(soa_ptr), index_(index) {}
+
+  public:
+    Iterator() : soa_ptr_(nullptr), index_(0) {}
+
+    template<bool OtherConst, class = std::enable_if_t<Const && !OtherConst>>
+    Iterator(const Iterator<OtherConst> &other) : soa_ptr_(other.soa_ptr_), index_(other.index_) {}
+
+    Iterator operator+(difference_type n) const {
+      return {soa_ptr_, index_ + n};
+    }
+
+    friend Iterator operator+(difference_type n, const Iterator &it) {
+      return it + n;
+    }
+
+    Iterator operator-(difference_type n) const {
+      return {soa_ptr_, index_ - n};
+    }
+
+    // if these two iterators point to different containers, throw invaild_iterator.
+    difference_type operator-(const Iterator &rhs) const {
+      if (soa_ptr_ != rhs.soa_ptr_) {
+        throw invalid_iterator();
+      }
+      return static_cast<difference_type>(index_ - rhs.index_);
+    }
+
+    Iterator &operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+
+    Iterator &operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator old = *this;
+      ++index_;
+      return old;
+    }
+
+    Iterator &operator++() {
+      ++index_;
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      Iterator old = *this;
+      --index_;
+      return old;
+    }
+
+    Iterator &operator--() {
+      --index_;
+      return *this;
+    }
+
+    reference operator*() const {
+      return {soa_ptr_, index_};
+    }
+
+    reference operator[](difference_type n) const {
+      return {soa_ptr_, index_ + n};
+    }
+
+    bool operator==(const Iterator &rhs) const {
+      return soa_ptr_ == rhs.soa_ptr_ && index_ == rhs.index_;
+    }
+
+    bool operator!=(const Iterator &rhs) const {
+      return !(*this == rhs);
+    }
+
+    bool operator<(const Iterator &rhs) const {
+      return index_ < rhs.index_;
+    }
+
+    bool operator>(const Iterator &rhs) const {
+      return index_ > rhs.index_;
+    }
+
+    bool operator<=(const Iterator &rhs) const {
+      return index_ <= rhs.index_;
+    }
+
+    bool operator>=(const Iterator &rhs) const {
+      return index_ >= rhs.index_;
+    }
+  };
+
+public:
+  using reference = RowReference<false>;
+  using const_reference = RowReference<true>;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  soa_vector() = default;
+
+  /**
+   * access the row at pos with bounds checking
+   * throw index_out_of_bound if pos is not in [0, size)
+   */
+  reference at(const size_t &pos) {
+    if (pos >= size()) {
+      throw index_out_of_bound();
+    }
+    return {this, pos};
+  }
+
+  const_reference at(const size_t &pos) const {
+    if (pos >= size()) {
+      throw index_out_of_bound();
+    }
+    return {this, pos};
+  }
+
+  reference operator[](const size_t &pos) {
+    return at(pos);
+  }
+
+  const_reference operator[](const size_t &pos) const {
+    return at(pos);
+  }
+
+  /**
+   * access the first / last row.
+   * throw container_is_empty if size == 0
+   */
+  reference front() {
+    return Edge(0);
+  }
+
+  const_reference front() const {
+    return Edge(0);
+  }
+
+  reference back() {
+    return Edge(size() - 1);
+  }
+
+  const_reference back() const {
+    return Edge(size() - 1);
+  }
+
+  /**
+   * returns field I of every row as one contiguous array of column_type<I>.
+   * it is invalidated, like a pointer into an sjtu::vector, by anything that may reallocate.
+   */
+  template<size_t I>
+  unchecked_view<column_type<I>> column() {
+    return unchecked_view<column_type<I>>(std::get<I>(columns_));
+  }
+
+  template<size_t I>
+  unchecked_view<const column_type<I>> column() const {
+    return unchecked_view<const column_type<I>>(std::get<I>(columns_));
+  }
+
+  iterator begin() {
+    return {this, 0};
+  }
+
+  const_iterator begin() const {
+    return {this, 0};
+  }
+
+  const_iterator cbegin() const {
+    return {this, 0};
+  }
+
+  iterator end() {
+    return {this, size()};
+  }
+
+  const_iterator end() const {
+    return {this, size()};
+  }
+
+  const_iterator cend() const {
+    return {this, size()};
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  size_t size() const {
+    return std::get<0>(columns_).size();
+  }
+
+  void reserve(size_t new_cap) {
+    std::apply([new_cap](auto &...column) { (column.reserve(new_cap), ...); }, columns_);
+  }
+
+  void shrink_to_fit() {
+    std::apply([](auto &...column) { (column.shrink_to_fit(), ...); }, columns_);
+  }
+
+  void clear() {
+    std::apply([](auto &...column) { (column.clear(), ...); }, columns_);
+  }
+
+  /**
+   * appends a row.
+   */
+  void push_back(const Fields &...values) {
+    PushBack<0>(std::forward_as_tuple(values...));
+  }
+
+  void push_back(const value_type &row) {
+    PushBack<0>(row);
+  }
+
+  /**
+   * removes the last row.
+   * throw container_is_empty if size() == 0
+   */
+  void pop_back() {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    std::apply([](auto &...column) { (column.pop_back(), ...); }, columns_);
+  }
+
+  /**
+   * inserts a row at index ind.
+   * throw index_out_of_bound if ind > size
+   */
+  iterator insert(const size_t &ind, const value_type &row) {
+    if (ind > size()) {
+      throw index_out_of_bound();
+    }
+    Insert<0>(ind, row);
+    return {this, ind};
+  }
+
+  iterator insert(const_iterator pos, const value_type &row) {
+    return insert(pos.index_, row);
+  }
+
+  /**
+   * removes the row at index ind.
+   * throw index_out_of_bound if ind >= size
+   */
+  iterator erase(const size_t &ind) {
+    if (ind >= size()) {
+      throw index_out_of_bound();
+    }
+    std::apply([ind](auto &...column) { (column.erase(ind), ...); }, columns_);
+    return {this, ind};
+  }
+
+  iterator erase(const_iterator pos) {
+    return erase(pos.index_);
+  }
+
+private:
+  template<size_t... I>
+  value_type Row(size_t ind, std::index_sequence<I...>) const {
+    return value_type(static_cast<Fields>(std::get<I>(columns_)[ind])...);
+  }
+
+  reference Edge(size_t ind) {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    return {this, ind};
+  }
+
+  const_reference Edge(size_t ind) const {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    return {this, ind};
+  }
+
+  // append field I onwards of row; if a later column throws, take field I back out.
+  template<size_t I, class Row>
+  void PushBack(const Row &row) {
+    if constexpr (I < sizeof...(Fields)) {
+      std::get<I>(columns_).push_back(std::get<I>(row));
+      try {
+        PushBack<I + 1>(row);
+      } catch (...) {
+        std::get<I>(columns_).pop_back();
+        throw;
+      }
+    }
+  }
+
+  template<size_t I>
+  void Insert(size_t ind, const value_type &row) {
+    if constexpr (I < sizeof...(Fields)) {
+      std::get<I>(columns_).insert(ind, std::get<I>(row));
+      try {
+        Insert<I + 1>(ind, row);
+      } catch (...) {
+        std::get<I>(columns_).erase(ind);
+        throw;
+      }
+    }
+  }
+
+  std::tuple<vector<std::conditional_t<std::is_same<Fields, bool>::value, unsigned char, Fields>>...> columns_;
+};
+
+}
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef SJTU_SORT_HPP
+#define SJTU_SORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include "parallel.hpp"
+#include "vector.hpp"
+
+namespace sjtu {
+namespace par {
+
+/**
+ * ranges shorter than this are sorted by std::sort / std::stable_sort on the calling thread.
+ */
+const size_t kSortSerialThreshold = 1 << 14;
+
+// whether sorting T with Compare is plain ascending order of integers, which the radix sort can do.
+template<class T, class Compare>
+constexpr bool kRadixSortable = std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+                                (std::is_same<Compare, std::less<T>>::value ||
+                                 std::is_same<Compare, std::less<>>::value);
+
+// the key of x whose unsigned order is the order of x: signed values get their sign bit flipped.
+template<class T>
+typename std::make_unsigned<T>::type RadixKey(T x) {
+  using U = typename std::make_unsigned<T>::type;
+  U key = static_cast<U>(x);
+  if (std::is_signed<T>::value) {
+    key ^= U(1) << (sizeof(T) * 8 - 1);
+  }
+  return key;
+}
+
+// the value whose RadixKey is key.
+template<class T>
+T RadixValue(typename std::make_unsigned<T>::type key) {
+  using U = typename std::make_unsigned<T>::type;
+  if (std::is_signed<T>::value) {
+    key ^= U(1) << (sizeof(T) * 8 - 1);
+  }
+  return static_cast<T>(key);
+}
+
+/**
+ * a parallel counting sort for integers of at most 16 bits.
+ * the elements are their own keys, so once every chunk has counted its values the range is rewritten in place
+ *   from the counts, without the buffer of the radix sort; each chunk fills its own part of the output.
+ */
+template<class RandomIt>
+void CountingSort(RandomIt first, RandomIt last, thread_pool &pool) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  const size_t kValues = size_t(1) << (sizeof(T) * 8);
+  size_t n = last - first;
+  vector<size_t> counts(pool.size() * 8 * kValues);
+  size_t *all_counts = counts.data();
+  size_t chunks = ForChunks(pool, n, [&](size_t c, size_t begin, size_t end) {
+    size_t *count = all_counts + c * kValues;
+    std::fill(count, count + kValues, 0);
+    for (size_t i = begin; i < end; i++) {
+      count[RadixKey(first[i])]++;
+    }
+  });
+  // the elements with key k go to [starts[k], starts[k + 1]).
+  vector<size_t> starts(kValues + 1);
+  size_t *start = starts.data();
+  start[0] = 0;
+  for (size_t k = 0; k < kValues; k++) {
+    size_t total = 0;
+    for (size_t c = 0; c < chunks; c++) {
+      total += all_counts[c * kValues + k];
+    }
+    start[k + 1] = start[k] + total;
+  }
+  ForChunks(pool, n, [&](size_t, size_t begin, size_t end) {
+    size_t k = std::upper_bound(start, start + kValues + 1, begin) - start - 1;
+    for (size_t i = begin; i < end; k++) {
+      size_t stop = std::min(start[k + 1], end);
+      std::fill(first + i, first + stop, RadixValue<T>(k));
+      i = stop;
+    }
+  });
+}
+
+/**
+ * a parallel LSD radix sort on bytes, stable.
+ * each pass counts the digits of every chunk, turns the counts into per-chunk offsets and scatters the chunks
+ *   concurrently; a pass whose digit is the same for every element is skipped.
+ * integers of at most 16 bits are counting sorted instead when the count tables are no larger than the range.
+ */
+template<class RandomIt>
+void RadixSort(RandomIt first, RandomIt last, thread_pool &pool) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  const size_t kBuckets = 256;
+  size_t n = last - first;
+  if constexpr (sizeof(T) <= 2) {
+    if (pool.size() * 8 * (size_t(1) << (sizeof(T) * 8)) <= n) {
+      CountingSort(first, last, pool);
+      return;
+    }
+  }
+  vector<T> buffer(n);
+  vector<size_t> counts(pool.size() * 8 * kBuckets);
+  // the loops below index the raw storage, without the bounds checks of vector::operator[].
+  T *buf = buffer.data();
+  size_t *all_counts = counts.data();
+  bool in_buffer = false;
+  for (size_t shift = 0; shift < sizeof(T) * 8; shift += 8) {
+    auto read = [&](size_t i) -> T & { return in_buffer ? buf[i] : first[i]; };
+    auto write = [&](size_t i) -> T & { return in_buffer ? first[i] : buf[i]; };
+    size_t chunks = ForChunks(pool, n, [&](size_t c, size_t begin, size_t end) {
+      size_t *count = all_counts + c * kBuckets;
+      std::fill(count, count + kBuckets, 0);
+      for (size_t i = begin; i < end; i++) {
+        count[(RadixKey(read(i)) >> shift) & 0xff]++;
+      }
+    });
+    bool trivial = false;
+    size_t offset = 0;
+    for (size_t b = 0; b < kBuckets; b++) {
+      size_t total = 0;
+      for (size_t c = 0; c < chunks; c++) {
+        size_t count = all_counts[c * kBuckets + b];
+        all_counts[c * kBuckets + b] = offset + total;
+        total += count;
+      }
+      trivial |= (total == n);
+      offset += total;
+    }
+    if (trivial) {
+      continue;
+    }
+    ForChunks(pool, n, [&](size_t c, size_t begin, size_t end) {
+      size_t *next = all_counts + c * kBuckets;
+      for (size_t i = begin; i < end; i++) {
+        write(next[(RadixKey(read(i)) >> shift) & 0xff]++) = read(i);
+      }
+    });
+    in_buffer = !in_buffer;
+  }
+  if (in_buffer) {
+    ForChunks(pool, n, [&](size_t, size_t begin, size_t end) {
+      std::copy(buf + begin, buf + end, first + begin);
+    });
+  }
+}
+
+// the number of elements of a that come before the d-th element of the stable merge of a and b.
+template<class It, class Compare>
+size_t MergePath(It a, size_t na, It b, size_t nb, size_t d, Compare &comp) {
+  size_t lo = d > nb ? d - nb : 0, hi = d < na ? d : na;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (!comp(b[d - mid - 1], a[mid])) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+/**
+ * a parallel merge sort.
+ * the range is cut into a few runs per thread, the runs are sorted concurrently by sort_run, then merged in
+ *   rounds between the range and a buffer. each merge is split along its merge path into pieces merged
+ *   concurrently, so the last rounds, which have few runs, still use every thread.
+ * the merges are stable, so the whole sort is stable when sort_run is.
+ */
+template<class RandomIt, class Compare, class SortRun>
+void MergeSort(RandomIt first, RandomIt last, Compare comp, SortRun sort_run, thread_pool &pool) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  size_t n = last - first;
+  size_t runs = pool.size() * 4;
+  size_t run_size = (n + runs - 1) / runs;
+  runs = (n + run_size - 1) / run_size;
+  pool.run(runs, [&](size_t r) {
+    size_t begin = r * run_size, end = std::min(begin + run_size, n);
+    sort_run(first + begin, first + end, comp);
+  });
+  if (runs == 1) {
+    return;
+  }
+  // the runs are moved into the buffer, so the first round merges them back into the range.
+  vector<T> buffer(std::make_move_iterator(first), std::make_move_iterator(last));
+  typename vector<T>::iterator buf = buffer.begin();
+  vector<size_t> splits;
+  bool in_buffer = true;
+  for (size_t len = run_size; len < n; len *= 2) {
+    size_t pairs = (n + 2 * len - 1) / (2 * len);
+    size_t pieces = (pool.size() * 4 + pairs - 1) / pairs;
+    // the splits are all found before any element is moved, since a search may probe a neighbouring piece.
+    splits.resize(pairs * (pieces + 1));
+    auto run_pieces = [&](auto src, auto dst) {
+      pool.run(pairs * (pieces + 1), [&](size_t task) {
+        size_t p = task / (pieces + 1), piece = task % (pieces + 1);
+        size_t begin = p * 2 * len, mid = std::min(begin + len, n), end = std::min(begin + 2 * len, n);
+        size_t d = (end - begin) * piece / pieces;
+        splits[task] = MergePath(src + begin, mid - begin, src + mid, end - mid, d, comp);
+      });
+      pool.run(pairs * pieces, [&](size_t task) {
+        size_t p = task / pieces, piece = task % pieces;
+        size_t begin = p * 2 * len, mid = std::min(begin + len, n), end = std::min(begin + 2 * len, n);
+        size_t d0 = (end - begin) * piece / pieces, d1 = (end - begin) * (piece + 1) / pieces;
+        size_t i0 = splits[p * (pieces + 1) + piece], i1 = splits[p * (pieces + 1) + piece + 1];
+        std::merge(std::make_move_iterator(src + begin + i0), std::make_move_iterator(src + begin + i1),
+                   std::make_move_iterator(src + mid + (d0 - i0)), std::make_move_iterator(src + mid + (d1 - i1)),
+                   dst + begin + d0, comp);
+      });
+    };
+    if (in_buffer) {
+      run_pieces(buf, first);
+    } else {
+      run_pieces(first, buf);
+    }
+    in_buffer = !in_buffer;
+  }
+  if (in_buffer) {
+    ForChunks(pool, n, [&](size_t, size_t begin, size_t end) {
+      std::move(buf + begin, buf + end, first + begin);
+    });
+  }
+}
+
+}
+
+/**
+ * sorts [first, last) by comp, using the threads of pool.
+ * ascending integers are radix sorted, anything else is merge sorted in parallel from runs sorted by std::sort.
+ *   short ranges, and other ranges when the pool has a single thread, are left to std::sort (introsort).
+ * the iterators must be random access, e.g. those of sjtu::vector.
+ */
+template<class RandomIt, class Compare = std::less<>>
+void sort(RandomIt first, RandomIt last, Compare comp = Compare(),
+          par::thread_pool &pool = par::thread_pool::instance()) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  if (static_cast<size_t>(last - first) < par::kSortSerialThreshold) {
+    std::sort(first, last, comp);
+  } else if constexpr (par::kRadixSortable<T, Compare>) {
+    par::RadixSort(first, last, pool);
+  } else if (pool.size() == 1) {
+    std::sort(first, last, comp);
+  } else {
+    par::MergeSort(first, last, comp, [](RandomIt l, RandomIt r, Compare &c) { std::sort(l, r, c); }, pool);
+  }
+}
+
+/**
+ * like sort, but keeps the order of equivalent elements.
+ */
+template<class RandomIt, class Compare = std::less<>>
+void stable_sort(RandomIt first, RandomIt last, Compare comp = Compare(),
+                 par::thread_pool &pool = par::thread_pool::instance()) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  if (static_cast<size_t>(last - first) < par::kSortSerialThreshold) {
+    std::stable_sort(first, last, comp);
+  } else if constexpr (par::kRadixSortable<T, Compare>) {
+    par::RadixSort(first, last, pool);
+  } else if (pool.size() == 1) {
+    std::stable_sort(first, last, comp);
+  } else {
+    par::MergeSort(first, last, comp, [](RandomIt l, RandomIt r, Compare &c) { std::stable_sort(l, r, c); }, pool);
+  }
+}
+
+}
+
+#endif
@@ -0,0 +1,508 @@
+#ifndef SJTU_TIERED_VECTOR_HPP
+#define SJTU_TIERED_VECTOR_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+namespace sjtu {
+
+/**
+ * a vector with O(sqrt n) insertion and erasure at any index and O(1) random access.
+ * the elements live in blocks of B slots, each a ring buffer, and every block but the last is full. element i
+ *   is slot i % B of block i / B, counted from the block's head.
+ * inserting at i shifts the rest of one block, then moves one element from the back of each later block to
+ *   the front of the next, which only turns the ring; erasing does the reverse. that is O(B + n / B) moves.
+ * B is a power of two kept near sqrt(n): the blocks are rebuilt with B doubled once n exceeds 2 B^2 and
+ *   halved once n drops below B^2 / 8.
+ * iterators hold an index; any insertion or erasure invalidates references to elements.
+ * elements are moved with their move constructor, which should not throw.
+ */
+template<typename T, typename Allocator = std::allocator<T>>
+class tiered_vector {
+public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+
+private:
+  template<bool Const>
+  class Iterator {
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+    using iterator_category = std::random_access_iterator_tag;
+
+  private:
+    friend class tiered_vector;
+    friend class Iterator<!Const>;
+
+    using Container = std::conditional_t<Const, const tiered_vector, tiered_vector>;
+
+    Container *vec_ptr_;
+    size_t index_;
+
+    Iterator(Container *vec_ptr, size_t index) : vec_ptr_(vec_ptr), index_(index) {}
+
+  public:
+    Iterator() : vec_ptr_(nullptr), index_(0) {}
+
+    template<bool OtherConst, class = std::enable_if_t<Const && !OtherConst>>
+    Iterator(const Iterator<OtherConst> &other) : vec_ptr_(other.vec_ptr_), index_(other.index_) {}
+
+    Iterator operator+(difference_type n) const {
+      return {vec_ptr_, index_ + n};
+    }
+
+    friend Iterator operator+(difference_type n, const Iterator &it) {
+      return it + n;
+    }
+
+    Iterator operator-(difference_type n) const {
+      return {vec_ptr_, index_ - n};
+    }
+
+    // if these two iterators point to different vectors, throw invaild_iterator.
+    difference_type operator-(const Iterator &rhs) const {
+      if (vec_ptr_ != rhs.vec_ptr_) {
+        throw invalid_iterator();
+      }
+      return static_cast<difference_type>(index_ - rhs.index_);
+    }
+
+    Iterator &operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+
+    Iterator &operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator old = *this;
+      ++index_;
+      return old;
+    }
+
+    Iterator &operator++() {
+      ++index_;
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      Iterator old = *this;
+      --index_;
+      return old;
+    }
+
+    Iterator &operator--() {
+      --index_;
+      return *this;
+    }
+
+    reference operator*() const {
+      return vec_ptr_->Element(index_);
+    }
+
+    pointer operator->() const {
+      return &vec_ptr_->Element(index_);
+    }
+
+    reference operator[](difference_type n) const {
+      return vec_ptr_->Element(index_ + n);
+    }
+
+    bool operator==(const Iterator &rhs) const {
+      return vec_ptr_ == rhs.vec_ptr_ && index_ == rhs.index_;
+    }
+
+    bool operator!=(const Iterator &rhs) const {
+      return !(*this == rhs);
+    }
+
+    bool operator<(const Iterator &rhs) const {
+      return index_ < rhs.index_;
+    }
+
+    bool operator>(const Iterator &rhs) const {
+      return index_ > rhs.index_;
+    }
+
+    bool operator<=(const Iterator &rhs) const {
+      return index_ <= rhs.index_;
+    }
+
+    bool operator>=(const Iterator &rhs) const {
+      return index_ >= rhs.index_;
+    }
+  };
+
+public:
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  tiered_vector() : tiered_vector(Allocator()) {}
+
+  explicit tiered_vector(const Allocator &alloc) : alloc_(alloc), shift_(kMinShift), size_(0) {}
+
+  tiered_vector(size_t count, const T &value, const Allocator &alloc = Allocator()) : tiered_vector(alloc) {
+    try {
+      for (size_t i = 0; i < count; i++) {
+        push_back(value);
+      }
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
+  template<class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  tiered_vector(InputIt first, InputIt last, const Allocator &alloc = Allocator()) : tiered_vector(alloc) {
+    try {
+      for (; first != last; ++first) {
+        push_back(*first);
+      }
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
+  tiered_vector(const tiered_vector &other)
+      : tiered_vector(AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+    shift_ = other.shift_;
+    try {
+      for (size_t i = 0; i < other.size_; i++) {
+        Append(T(other.Element(i)));
+      }
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
+  tiered_vector(tiered_vector &&other) noexcept : tiered_vector(other.alloc_) {
+    swap(other);
+  }
+
+  tiered_vector &operator=(const tiered_vector &other) {
+    if (this != &other) {
+      tiered_vector tmp(other);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  tiered_vector &operator=(tiered_vector &&other) noexcept {
+    if (this != &other) {
+      clear();
+      swap(other);
+    }
+    return *this;
+  }
+
+  ~tiered_vector() {
+    clear();
+  }
+
+  void swap(tiered_vector &other) noexcept {
+    using std::swap;
+    swap(alloc_, other.alloc_);
+    blocks_.swap(other.blocks_);
+    swap(shift_, other.shift_);
+    swap(size_, other.size_);
+  }
+
+  friend void swap(tiered_vector &lhs, tiered_vector &rhs) noexcept {
+    lhs.swap(rhs);
+  }
+
+  allocator_type get_allocator() const {
+    return alloc_;
+  }
+
+  /**
+   * access specified element with bounds checking
+   * throw index_out_of_bound if pos is not in [0, size)
+   */
+  T &at(const size_t &pos) {
+    if (pos >= size_) {
+      throw index_out_of_bound();
+    }
+    return Element(pos);
+  }
+
+  const T &at(const size_t &pos) const {
+    if (pos >= size_) {
+      throw index_out_of_bound();
+    }
+    return Element(pos);
+  }
+
+  T &operator[](const size_t &pos) {
+    return at(pos);
+  }
+
+  const T &operator[](const size_t &pos) const {
+    return at(pos);
+  }
+
+  /**
+   * access the first / last element.
+   * throw container_is_empty if size == 0
+   */
+  T &front() {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    return Element(0);
+  }
+
+  const T &front() const {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    return Element(0);
+  }
+
+  T &back() {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    return Element(size_ - 1);
+  }
+
+  const T &back() const {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    return Element(size_ - 1);
+  }
+
+  iterator begin() {
+    return {this, 0};
+  }
+
+  const_iterator begin() const {
+    return {this, 0};
+  }
+
+  const_iterator cbegin() const {
+    return {this, 0};
+  }
+
+  iterator end() {
+    return {this, size_};
+  }
+
+  const_iterator end() const {
+    return {this, size_};
+  }
+
+  const_iterator cend() const {
+    return {this, size_};
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  /**
+   * clears the contents and frees the storage
+   */
+  void clear() {
+    for (size_t i = 0; i < size_; i++) {
+      AllocTraits::destroy(alloc_, &Element(i));
+    }
+    while (!blocks_.empty()) {
+      PopBlock();
+    }
+    size_ = 0;
+    shift_ = kMinShift;
+  }
+
+  /**
+   * inserts value before pos / at index ind.
+   * throw index_out_of_bound if ind > size
+   */
+  iterator insert(const_iterator pos, const T &value) {
+    return insert(pos.index_, value);
+  }
+
+  iterator insert(const_iterator pos, T &&value) {
+    return insert(pos.index_, std::move(value));
+  }
+
+  iterator insert(const size_t &ind, const T &value) {
+    return insert(ind, T(value));
+  }
+
+  iterator insert(const size_t &ind, T &&value) {
+    if (ind > size_) {
+      throw index_out_of_bound();
+    }
+    InsertAt(ind, std::move(value));
+    return {this, ind};
+  }
+
+  /**
+   * removes the element at pos / at index ind.
+   * throw index_out_of_bound if ind >= size
+   */
+  iterator erase(const_iterator pos) {
+    return erase(pos.index_);
+  }
+
+  iterator erase(const size_t &ind) {
+    if (ind >= size_) {
+      throw index_out_of_bound();
+    }
+    EraseAt(ind);
+    return {this, ind};
+  }
+
+  void push_back(const T &value) {
+    InsertAt(size_, T(value));
+  }
+
+  void push_back(T &&value) {
+    InsertAt(size_, std::move(value));
+  }
+
+  /**
+   * throw container_is_empty if size() == 0
+   */
+  void pop_back() {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    EraseAt(size_ - 1);
+  }
+
+private:
+  using AllocTraits = std::allocator_traits<Allocator>;
+
+  struct Block {
+    T *slots_;
+    size_t head_;
+  };
+
+  static const size_t kMinShift = 4;
+
+  size_t Mask() const {
+    return (size_t(1) << shift_) - 1;
+  }
+
+  // the slot at position pos of block b, counted from the block's head.
+  T &Slot(size_t b, size_t pos) const {
+    const Block &block = blocks_[b];
+    return block.slots_[(block.head_ + pos) & Mask()];
+  }
+
+  T &Element(size_t ind) const {
+    return Slot(ind >> shift_, ind & Mask());
+  }
+
+  // move-construct dest from src and destroy src.
+  void Move(T &dest, T &src) {
+    AllocTraits::construct(alloc_, &dest, std::move(src));
+    AllocTraits::destroy(alloc_, &src);
+  }
+
+  void AddBlock() {
+    blocks_.push_back(Block{AllocTraits::allocate(alloc_, Mask() + 1), 0});
+  }
+
+  void PopBlock() {
+    AllocTraits::deallocate(alloc_, blocks_.back().slots_, Mask() + 1);
+    blocks_.pop_back();
+  }
+
+  void Append(T &&value) {
+    if (size_ == blocks_.size() << shift_) {
+      AddBlock();
+    }
+    AllocTraits::construct(alloc_, &Element(size_), std::move(value));
+    size_++;
+  }
+
+  void InsertAt(size_t ind, T &&value) {
+    if (size_ == blocks_.size() << shift_) {
+      AddBlock();
+    }
+    size_t mask = Mask(), k = ind >> shift_, last = size_ >> shift_;
+    // turn every later block one slot back and fill its new head with the last element of the block before.
+    for (size_t b = last; b > k; b--) {
+      blocks_[b].head_ = (blocks_[b].head_ - 1) & mask;
+      Move(Slot(b, 0), Slot(b - 1, mask));
+    }
+    // block k now has one free slot at its end.
+    size_t end = (k == last ? size_ & mask : mask), off = ind & mask;
+    for (size_t p = end; p > off; p--) {
+      Move(Slot(k, p), Slot(k, p - 1));
+    }
+    AllocTraits::construct(alloc_, &Slot(k, off), std::move(value));
+    size_++;
+    Rebalance();
+  }
+
+  void EraseAt(size_t ind) {
+    size_t mask = Mask(), k = ind >> shift_, last = (size_ - 1) >> shift_;
+    size_t end = (k == last ? (size_ - 1) & mask : mask), off = ind & mask;
+    AllocTraits::destroy(alloc_, &Slot(k, off));
+    for (size_t p = off; p < end; p++) {
+      Move(Slot(k, p), Slot(k, p + 1));
+    }
+    // refill the end of each block with the head of the next, turning the next one slot forward.
+    for (size_t b = k + 1; b <= last; b++) {
+      Move(Slot(b - 1, mask), Slot(b, 0));
+      blocks_[b].head_ = (blocks_[b].head_ + 1) & mask;
+    }
+    size_--;
+    if (size_ <= (blocks_.size() - 1) << shift_) {
+      PopBlock();
+    }
+    Rebalance();
+  }
+
+  void Rebalance() {
+    if (size_ > (size_t(2) << (2 * shift_))) {
+      Rebuild(shift_ + 1);
+    } else if (shift_ > kMinShift && size_ < (size_t(1) << (2 * shift_)) / 8) {
+      Rebuild(shift_ - 1);
+    }
+  }
+
+  // move the elements into blocks of 2^new_shift slots.
+  void Rebuild(size_t new_shift) {
+    tiered_vector tmp(alloc_);
+    tmp.shift_ = new_shift;
+    for (size_t i = 0; i < size_; i++) {
+      tmp.Append(std::move(Element(i)));
+    }
+    swap(tmp);
+  }
+
+  Allocator alloc_;
+  vector<Block> blocks_;
+  size_t shift_, size_;
+};
+
+}
+
+#endif
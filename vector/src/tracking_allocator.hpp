@@ -0,0 +1,244 @@
+#ifndef SJTU_TRACKING_ALLOCATOR_HPP
+#define SJTU_TRACKING_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace sjtu {
+
+/**
+ * a record of the live heap blocks of the containers, a fast replacement for running the memcheck datasets
+ *   under valgrind.
+ * every tracked block is registered with its size when it is allocated and removed when it is freed:
+ *   - freeing a block that is not live (a double free, or a pointer never allocated here) is counted and the
+ *     free is skipped, so the program keeps running;
+ *   - freeing a block with another size than it was allocated with is counted as a size mismatch.
+ * a block freed twice is only caught if its address was not handed out again in between.
+ * the containers route their allocations through it when SJTU_TRACK_ALLOCATIONS is defined (see
+ *   tracking_allocator, tracked_new and tracked_delete); at exit the result is reported on stderr and the
+ *   exit status is 1 if there is a leak, a double free or a size mismatch.
+ * thread-safe.
+ */
+class allocation_tracker {
+public:
+  /**
+   * the tracker of the program. it is never destroyed, so that blocks freed during static destruction are
+   *   still recorded.
+   */
+  static allocation_tracker &instance() {
+    static allocation_tracker *tracker = new allocation_tracker();
+    return *tracker;
+  }
+
+  allocation_tracker(const allocation_tracker &other) = delete;
+
+  allocation_tracker &operator=(const allocation_tracker &other) = delete;
+
+  void allocated(const void *p, size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    blocks_[p] = bytes;
+    allocations_++;
+    live_bytes_ += bytes;
+    if (live_bytes_ > peak_bytes_) {
+      peak_bytes_ = live_bytes_;
+    }
+  }
+
+  /**
+   * records that p, of the given size, is being freed.
+   * returns whether p is a live block; if not, it must not be freed.
+   */
+  bool deallocated(const void *p, size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = blocks_.find(p);
+    if (it == blocks_.end()) {
+      double_frees_++;
+      return false;
+    }
+    if (it->second != bytes) {
+      size_mismatches_++;
+    }
+    live_bytes_ -= it->second;
+    blocks_.erase(it);
+    return true;
+  }
+
+  /**
+   * the number of allocations so far, and the number / total size of the blocks not yet freed.
+   */
+  size_t allocations() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return allocations_;
+  }
+
+  size_t live_blocks() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return blocks_.size();
+  }
+
+  size_t live_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return live_bytes_;
+  }
+
+  /**
+   * the largest live_bytes() so far.
+   */
+  size_t peak_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return peak_bytes_;
+  }
+
+  size_t double_frees() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return double_frees_;
+  }
+
+  size_t size_mismatches() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_mismatches_;
+  }
+
+  /**
+   * writes a summary to out, followed by up to max_listed leaked blocks.
+   * returns whether no leak, double free or size mismatch was found.
+   */
+  bool report(std::FILE *out, size_t max_listed = 10) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::fprintf(out,
+                 "sjtu::allocation_tracker: %zu allocations, peak %zu bytes, %zu bytes leaked in %zu blocks, "
+                 "%zu double frees, %zu size mismatches\n",
+                 allocations_, peak_bytes_, live_bytes_, blocks_.size(), double_frees_, size_mismatches_);
+    size_t listed = 0;
+    for (auto it = blocks_.begin(); it != blocks_.end() && listed < max_listed; ++it, ++listed) {
+      std::fprintf(out, "  leaked %zu bytes at %p\n", it->second, it->first);
+    }
+    return blocks_.empty() && double_frees_ == 0 && size_mismatches_ == 0;
+  }
+
+private:
+  allocation_tracker() : allocations_(0), live_bytes_(0), peak_bytes_(0), double_frees_(0), size_mismatches_(0) {}
+
+  mutable std::mutex mutex_;
+  std::unordered_map<const void *, size_t> blocks_;
+  size_t allocations_, live_bytes_, peak_bytes_, double_frees_, size_mismatches_;
+};
+
+/**
+ * reports the tracker at exit if anything was tracked, and exits with status 1 if it found an error.
+ * it is constructed before, and so destroyed after, every object with static storage duration defined after
+ *   this header is included, so the containers among them are freed before the report.
+ */
+class allocation_reporter {
+public:
+  allocation_reporter() {
+    allocation_tracker::instance();
+  }
+
+  allocation_reporter(const allocation_reporter &other) = delete;
+
+  allocation_reporter &operator=(const allocation_reporter &other) = delete;
+
+  ~allocation_reporter() {
+    allocation_tracker &tracker = allocation_tracker::instance();
+    if (tracker.allocations() != 0 && !tracker.report(stderr)) {
+      std::fflush(nullptr);
+      std::_Exit(1);
+    }
+  }
+};
+
+inline allocation_reporter allocation_reporter_instance;
+
+/**
+ * an allocator using operator new / delete that registers every block with allocation_tracker.
+ * the default allocator of sjtu::vector when SJTU_TRACK_ALLOCATIONS is defined.
+ */
+template<typename T>
+class tracking_allocator {
+public:
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  tracking_allocator() = default;
+
+  template<typename U>
+  tracking_allocator(const tracking_allocator<U> &) {}
+
+  T *allocate(size_t n) {
+    T *res;
+    if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      res = static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    } else {
+      res = static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+    allocation_tracker::instance().allocated(res, n * sizeof(T));
+    return res;
+  }
+
+  void deallocate(T *p, size_t n) {
+    if (allocation_tracker::instance().deallocated(p, n * sizeof(T))) {
+      Free(p);
+    }
+  }
+
+  template<typename U>
+  bool operator==(const tracking_allocator<U> &) const {
+    return true;
+  }
+
+  template<typename U>
+  bool operator!=(const tracking_allocator<U> &) const {
+    return false;
+  }
+
+private:
+  template<typename U>
+  friend void tracked_delete(U *p);
+
+  static void Free(T *p) {
+    if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      ::operator delete(p, std::align_val_t(alignof(T)));
+    } else {
+      ::operator delete(p);
+    }
+  }
+};
+
+/**
+ * new / delete for a single object, tracked like tracking_allocator; used by the node-based containers when
+ *   SJTU_TRACK_ALLOCATIONS is defined.
+ * a second tracked_delete of the same object is counted as a double free without running the destructor again.
+ */
+template<typename T, typename... Args>
+T *tracked_new(Args &&... args) {
+  tracking_allocator<T> alloc;
+  T *res = alloc.allocate(1);
+  try {
+    new(res) T(std::forward<Args>(args)...);
+  } catch (...) {
+    alloc.deallocate(res, 1);
+    throw;
+  }
+  return res;
+}
+
+template<typename T>
+void tracked_delete(T *p) {
+  using Object = std::remove_const_t<T>;
+  if (p == nullptr || !allocation_tracker::instance().deallocated(p, sizeof(T))) {
+    return;
+  }
+  p->~T();
+  tracking_allocator<Object>::Free(const_cast<Object *>(p));
+}
+
+}
+
+#endif
@@ -5,15 +5,178 @@
 
 #include <climits>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#ifdef SJTU_TRACK_ALLOCATIONS
+#include "tracking_allocator.hpp"
+#endif
+
+// marks the members of vector that can run in constant evaluation, which needs C++20 for allocation, placement
+// construction and try blocks.
+#if __cplusplus >= 202002L
+#define SJTU_CONSTEXPR20 constexpr
+#else
+#define SJTU_CONSTEXPR20
+#endif
 
 namespace sjtu {
+/**
+ * whether an object of type T may be moved to another address by copying its bytes, without calling its move
+ * constructor at the new address or its destructor at the old one.
+ * it holds for trivially copyable types, and can be specialized as std::true_type for types that merely own a
+ * resource through a pointer, such as Util::Bint. the move constructor of such a type must not throw.
+ */
+template<typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+/**
+ * whether Allocator can resize a block it allocated, as `T *reallocate(T *p, size_t old_n, size_t new_n)`,
+ *   possibly in place (see mmap_allocator). the block is resized bytewise, so vector only uses it for trivially
+ *   relocatable elements.
+ */
+template<typename Allocator, typename T, typename = void>
+struct has_reallocate : std::false_type {};
+
+template<typename Allocator, typename T>
+struct has_reallocate<Allocator, T, std::void_t<decltype(std::declval<Allocator &>().reallocate(
+    std::declval<T *>(), std::declval<size_t>(), std::declval<size_t>()))>> : std::true_type {};
+
+/**
+ * growth policies of sjtu::vector.
+ * grow(capacity, required) returns the capacity to reallocate to when `required` elements do not fit in `capacity`;
+ *   it must be at least `required`.
+ * shrink(size, capacity) returns the capacity to shrink to after an erase, or `capacity` to keep the buffer.
+ * any class with these two member functions can be used as a custom policy.
+ */
+template<size_t Numerator, size_t Denominator, bool EnableShrink = true>
+struct geometric_growth {
+  static_assert(Numerator > Denominator, "the growth factor must be greater than 1");
+
+  constexpr size_t grow(size_t capacity, size_t required) const {
+    size_t res = capacity / Denominator * Numerator + capacity % Denominator * Numerator / Denominator;
+    return res < required ? required : res;
+  }
+
+  // shrink to half when only a quarter is used, so that a push/pop sequence oscillating around a boundary
+  // never reallocates twice in a row.
+  constexpr size_t shrink(size_t size, size_t capacity) const {
+    if (EnableShrink && size <= capacity / 4) {
+      return capacity / 2;
+    }
+    return capacity;
+  }
+};
+
+using double_growth = geometric_growth<2, 1>;
+using one_and_half_growth = geometric_growth<3, 2>;
+using double_growth_no_shrink = geometric_growth<2, 1, false>;
+
+/**
+ * the per-element encoding used by vector::save / vector::load for types that are not trivially copyable.
+ * specialize it with
+ *   template<class Writer> static void save(Writer &out, const T &value);
+ *   template<class Reader> static T load(Reader &in);
+ *   where out.write(const void *, size_t) and in.read(void *, size_t) transfer raw bytes and throw runtime_error
+ *   on failure.
+ */
+template<typename T>
+struct serializer;
+
+template<>
+struct serializer<std::string> {
+  template<class Writer>
+  static void save(Writer &out, const std::string &value) {
+    uint64_t length = value.size();
+    out.write(&length, sizeof(length));
+    out.write(value.data(), value.size());
+  }
+
+  template<class Reader>
+  static std::string load(Reader &in) {
+    uint64_t length;
+    in.read(&length, sizeof(length));
+    std::string res(length, '\0');
+    in.read(&res[0], length);
+    return res;
+  }
+};
+
+/**
+ * the allocator of vector when none is given: std::allocator, or tracking_allocator when SJTU_TRACK_ALLOCATIONS
+ *   is defined so that leak checks need no valgrind (a tracked vector cannot be used in constant evaluation).
+ */
+#ifdef SJTU_TRACK_ALLOCATIONS
+template<typename T>
+using default_allocator = tracking_allocator<T>;
+#else
+template<typename T>
+using default_allocator = std::allocator<T>;
+#endif
+
+/**
+ * counters of the work done by a vector, kept when SJTU_CONTAINER_STATS is defined (see vector::stats()).
+ *   - reallocations: the number of buffers taken, the first one and in-place resizes included;
+ *   - bytes_copied: the bytes of the elements copied or moved from one slot to another, by reallocation,
+ *     insertion and erasure (a copy of a whole vector counts too);
+ *   - peak_capacity: the largest capacity reached.
+ */
+struct vector_stats {
+  size_t reallocations = 0;
+  size_t bytes_copied = 0;
+  size_t peak_capacity = 0;
+
+  std::string to_json() const {
+    return "{\"reallocations\": " + std::to_string(reallocations) + ", \"bytes_copied\": " +
+           std::to_string(bytes_copied) + ", \"peak_capacity\": " + std::to_string(peak_capacity) + "}";
+  }
+};
+
+/**
+ * raw storage for N elements kept inside the container object, used by small_vector.
+ */
+template<typename T, size_t N>
+class inline_storage {
+protected:
+  T *InlineFirst() {
+    return reinterpret_cast<T *>(buffer_);
+  }
+
+  const T *InlineFirst() const {
+    return reinterpret_cast<const T *>(buffer_);
+  }
+
+private:
+  alignas(T) unsigned char buffer_[N * sizeof(T)];
+};
+
+template<typename T>
+class inline_storage<T, 0> {
+protected:
+  constexpr T *InlineFirst() const {
+    return nullptr;
+  }
+};
+
 /**
  * a data container like std::vector
  * store data in a successive memory and support random access.
+ * the first InlineCapacity elements are stored inside the object itself (see small_vector),
+ *   and a default-constructed vector allocates nothing.
+ * under C++20 a vector without inline capacity (and vector<bool>) can be used in constant evaluation, e.g. to
+ *   build a lookup table in a constexpr function; like std::vector, its storage must be freed before the
+ *   evaluation ends, so copy the result into an array to keep it.
  */
-template<typename T, typename Allocator = std::allocator<T>>
-class vector {
+template<typename T, typename Allocator = default_allocator<T>, typename GrowthPolicy = double_growth,
+         size_t InlineCapacity = 0>
+class vector : private inline_storage<T, InlineCapacity> {
 public:
   /**
    * a type for actions of the elements of a vector, and you should write
@@ -41,16 +204,23 @@ public:
     using value_type = T;
     using pointer = T *;
     using reference = T &;
-    using iterator_category = std::output_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus >= 202002L
+    using iterator_concept = std::contiguous_iterator_tag;
+#endif
 
   private:
+    friend class const_iterator;
+
     T *data_;
-    const vector<T> *vec_ptr_;
+    const vector *vec_ptr_;
 
   public:
-    iterator(T *data, const vector<T> *vec_ptr) : data_(data), vec_ptr_(vec_ptr) {}
+    SJTU_CONSTEXPR20 iterator() : data_(nullptr), vec_ptr_(nullptr) {}
 
-    iterator(const iterator &other) : data_(other.data_), vec_ptr_(other.vec_ptr_) {}
+    SJTU_CONSTEXPR20 iterator(T *data, const vector *vec_ptr) : data_(data), vec_ptr_(vec_ptr) {}
+
+    SJTU_CONSTEXPR20 iterator(const iterator &other) : data_(other.data_), vec_ptr_(other.vec_ptr_) {}
 
     iterator &operator=(const iterator &other) = default;
 
@@ -58,80 +228,131 @@ public:
      * return a new iterator which pointer n-next elements
      * as well as operator-
      */
-    iterator operator+(const int &n) const {
+    SJTU_CONSTEXPR20 iterator operator+(difference_type n) const {
       return {data_ + n, vec_ptr_};
     }
 
-    iterator operator-(const int &n) const {
+    friend SJTU_CONSTEXPR20 iterator operator+(difference_type n, const iterator &it) {
+      return it + n;
+    }
+
+    SJTU_CONSTEXPR20 iterator operator-(difference_type n) const {
       return {data_ - n, vec_ptr_};
     }
 
     // return the distance between two iterators,
     // if these two iterators point to different vectors, throw invaild_iterator.
-    int operator-(const iterator &rhs) const {
+    SJTU_CONSTEXPR20 difference_type operator-(const iterator &rhs) const {
+      if (vec_ptr_ != rhs.vec_ptr_) {
+        throw invalid_iterator();
+      }
+      return data_ - rhs.data_;
+    }
+
+    SJTU_CONSTEXPR20 difference_type operator-(const const_iterator &rhs) const {
       if (vec_ptr_ != rhs.vec_ptr_) {
         throw invalid_iterator();
       }
       return data_ - rhs.data_;
     }
 
-    iterator &operator+=(const int &n) {
+    SJTU_CONSTEXPR20 iterator &operator+=(difference_type n) {
       data_ += n;
       return *this;
     }
 
-    iterator &operator-=(const int &n) {
+    SJTU_CONSTEXPR20 iterator &operator-=(difference_type n) {
       data_ -= n;
       return *this;
     }
 
-    iterator operator++(int) {
+    SJTU_CONSTEXPR20 iterator operator++(int) {
       iterator old = *this;
       ++data_;
       return old;
     }
 
-    iterator &operator++() {
+    SJTU_CONSTEXPR20 iterator &operator++() {
       ++data_;
       return *this;
     }
 
-    iterator operator--(int) {
+    SJTU_CONSTEXPR20 iterator operator--(int) {
       iterator old = *this;
       --data_;
       return old;
     }
 
-    iterator &operator--() {
+    SJTU_CONSTEXPR20 iterator &operator--() {
       --data_;
       return *this;
     }
 
-    T &operator*() const {
+    SJTU_CONSTEXPR20 T &operator*() const {
       return *data_;
     }
 
+    SJTU_CONSTEXPR20 T *operator->() const {
+      return data_;
+    }
+
+    SJTU_CONSTEXPR20 T &operator[](difference_type n) const {
+      return data_[n];
+    }
+
     /**
      * a operator to check whether two iterators are same (pointing to the same memory address).
      */
-    bool operator==(const iterator &rhs) const {
+    SJTU_CONSTEXPR20 bool operator==(const iterator &rhs) const {
       return data_ == rhs.data_;
     }
 
-    bool operator==(const const_iterator &rhs) const {
+    SJTU_CONSTEXPR20 bool operator==(const const_iterator &rhs) const {
       return data_ == rhs.data_;
     }
 
     /**
      * some other operator for iterator.
      */
-    bool operator!=(const iterator &rhs) const {
+    SJTU_CONSTEXPR20 bool operator!=(const iterator &rhs) const {
       return data_ != rhs.data_;
     }
 
-    bool operator!=(const const_iterator &rhs) const {
+    SJTU_CONSTEXPR20 bool operator!=(const const_iterator &rhs) const {
       return data_ != rhs.data_;
     }
+
+    SJTU_CONSTEXPR20 bool operator<(const iterator &rhs) const {
+      return data_ < rhs.data_;
+    }
+
+    SJTU_CONSTEXPR20 bool operator>(const iterator &rhs) const {
+      return data_ > rhs.data_;
+    }
+
+    SJTU_CONSTEXPR20 bool operator<=(const iterator &rhs) const {
+      return data_ <= rhs.data_;
+    }
+
+    SJTU_CONSTEXPR20 bool operator>=(const iterator &rhs) const {
+      return data_ >= rhs.data_;
+    }
+
+    SJTU_CONSTEXPR20 bool operator<(const const_iterator &rhs) const {
+      return data_ < rhs.data_;
+    }
+
+    SJTU_CONSTEXPR20 bool operator>(const const_iterator &rhs) const {
+      return data_ > rhs.data_;
+    }
+
+    SJTU_CONSTEXPR20 bool operator<=(const const_iterator &rhs) const {
+      return data_ <= rhs.data_;
+    }
+
+    SJTU_CONSTEXPR20 bool operator>=(const const_iterator &rhs) const {
+      return data_ >= rhs.data_;
+    }
   };
 
   /**
@@ -141,18 +362,25 @@ public:
   public:
     using difference_type = std::ptrdiff_t;
     using value_type = T;
-    using pointer = T *;
-    using reference = T &;
-    using iterator_category = std::output_iterator_tag;
+    using pointer = const T *;
+    using reference = const T &;
+    using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus >= 202002L
+    using iterator_concept = std::contiguous_iterator_tag;
+#endif
 
   private:
+    friend class iterator;
+
     const T *data_;
-    const vector<T> *vec_ptr_;
+    const vector *vec_ptr_;
 
   public:
-    const_iterator(const T *data, const vector<T> *vec_ptr) : data_(data), vec_ptr_(vec_ptr) {}
+    SJTU_CONSTEXPR20 const_iterator() : data_(nullptr), vec_ptr_(nullptr) {}
+
+    SJTU_CONSTEXPR20 const_iterator(const T *data, const vector *vec_ptr) : data_(data), vec_ptr_(vec_ptr) {}
 
-    const_iterator(const iterator &other) : data_(other.data_), vec_ptr_(other.vec_ptr_) {}
+    SJTU_CONSTEXPR20 const_iterator(const iterator &other) : data_(other.data_), vec_ptr_(other.vec_ptr_) {}
 
     const_iterator &operator=(const const_iterator &other) = default;
 
@@ -160,129 +388,287 @@ public:
      * return a new iterator which pointer n-next elements
      * as well as operator-
      */
-    const_iterator operator+(const int &n) const {
+    SJTU_CONSTEXPR20 const_iterator operator+(difference_type n) const {
       return {data_ + n, vec_ptr_};
     }
 
-    const_iterator operator-(const int &n) const {
+    friend SJTU_CONSTEXPR20 const_iterator operator+(difference_type n, const const_iterator &it) {
+      return it + n;
+    }
+
+    SJTU_CONSTEXPR20 const_iterator operator-(difference_type n) const {
       return {data_ - n, vec_ptr_};
     }
 
     // return the distance between two iterators,
     // if these two iterators point to different vectors, throw invaild_iterator.
-    int operator-(const const_iterator &rhs) const {
+    SJTU_CONSTEXPR20 difference_type operator-(const const_iterator &rhs) const {
       if (vec_ptr_ != rhs.vec_ptr_) {
         throw invalid_iterator();
       }
       return data_ - rhs.data_;
     }
 
-    const_iterator &operator+=(const int &n) {
+    SJTU_CONSTEXPR20 const_iterator &operator+=(difference_type n) {
       data_ += n;
       return *this;
     }
 
-    const_iterator &operator-=(const int &n) {
+    SJTU_CONSTEXPR20 const_iterator &operator-=(difference_type n) {
       data_ -= n;
       return *this;
     }
 
-    const_iterator operator++(int) {
-      iterator old = *this;
+    SJTU_CONSTEXPR20 const_iterator operator++(int) {
+      const_iterator old = *this;
       ++data_;
       return old;
     }
 
-    const_iterator &operator++() {
+    SJTU_CONSTEXPR20 const_iterator &operator++() {
       ++data_;
       return *this;
     }
 
-    const_iterator operator--(int) {
-      iterator old = *this;
+    SJTU_CONSTEXPR20 const_iterator operator--(int) {
+      const_iterator old = *this;
       --data_;
       return old;
     }
 
-    const_iterator &operator--() {
+    SJTU_CONSTEXPR20 const_iterator &operator--() {
       --data_;
       return *this;
     }
 
-    const T &operator*() const {
+    SJTU_CONSTEXPR20 const T &operator*() const {
       return *data_;
     }
 
+    SJTU_CONSTEXPR20 const T *operator->() const {
+      return data_;
+    }
+
+    SJTU_CONSTEXPR20 const T &operator[](difference_type n) const {
+      return data_[n];
+    }
+
     /**
      * a operator to check whether two iterators are same (pointing to the same memory address).
      */
-    bool operator==(const iterator &rhs) const {
+    SJTU_CONSTEXPR20 bool operator==(const iterator &rhs) const {
       return data_ == rhs.data_;
     }
 
-    bool operator==(const const_iterator &rhs) const {
+    SJTU_CONSTEXPR20 bool operator==(const const_iterator &rhs) const {
       return data_ == rhs.data_;
     }
 
     /**
      * some other operator for iterator.
      */
-    bool operator!=(const iterator &rhs) const {
+    SJTU_CONSTEXPR20 bool operator!=(const iterator &rhs) const {
       return data_ != rhs.data_;
     }
 
-    bool operator!=(const const_iterator &rhs) const {
+    SJTU_CONSTEXPR20 bool operator!=(const const_iterator &rhs) const {
       return data_ != rhs.data_;
     }
+
+    SJTU_CONSTEXPR20 bool operator<(const const_iterator &rhs) const {
+      return data_ < rhs.data_;
+    }
+
+    SJTU_CONSTEXPR20 bool operator>(const const_iterator &rhs) const {
+      return data_ > rhs.data_;
+    }
+
+    SJTU_CONSTEXPR20 bool operator<=(const const_iterator &rhs) const {
+      return data_ <= rhs.data_;
+    }
+
+    SJTU_CONSTEXPR20 bool operator>=(const const_iterator &rhs) const {
+      return data_ >= rhs.data_;
+    }
   };
 
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+
   /**
    * Constructors
    * At least two: default constructor, copy constructor
+   * every constructor can be given the allocator to use; a stateful allocator (e.g. monotonic_arena_allocator)
+   *   is kept and used for all later allocations.
    */
-  vector() : alloc_(), first_(alloc_.allocate(minCapacity)), size_(0), capacity_(minCapacity) {}
+  SJTU_CONSTEXPR20 vector() : alloc_(), first_(this->InlineFirst()), size_(0), capacity_(InlineCapacity) {}
 
-  vector(const vector &other) : alloc_() {
-    first_ = alloc_.allocate(other.capacity_);
-    size_ = other.size_;
-    capacity_ = other.capacity_;
-    Copy(first_, other.first_, other.size_);
+  SJTU_CONSTEXPR20 explicit vector(const Allocator &alloc)
+      : alloc_(alloc), first_(this->InlineFirst()), size_(0), capacity_(InlineCapacity) {}
+
+  SJTU_CONSTEXPR20 vector(const vector &other)
+      : alloc_(AllocTraits::select_on_container_copy_construction(other.alloc_)), first_(this->InlineFirst()),
+        size_(0), capacity_(InlineCapacity) {
+    CopyFrom(other);
+  }
+
+  SJTU_CONSTEXPR20 vector(const vector &other, const Allocator &alloc)
+      : alloc_(alloc), first_(this->InlineFirst()), size_(0), capacity_(InlineCapacity) {
+    CopyFrom(other);
+  }
+
+  SJTU_CONSTEXPR20 vector(vector &&other) noexcept(InlineCapacity == 0 || kNothrowRelocate)
+      : alloc_(std::move(other.alloc_)), first_(this->InlineFirst()), size_(0), capacity_(InlineCapacity) {
+    StealFrom(other);
+  }
+
+  // the buffer of other is taken over only if alloc can free it; otherwise the elements are moved one by one.
+  SJTU_CONSTEXPR20 vector(vector &&other, const Allocator &alloc)
+      : alloc_(alloc), first_(this->InlineFirst()), size_(0), capacity_(InlineCapacity) {
+    MoveFrom(other);
+  }
+
+  /**
+   * constructs the container with count copies of value, or count value-initialized elements.
+   */
+  SJTU_CONSTEXPR20 vector(size_t count, const T &value, const Allocator &alloc = Allocator())
+      : alloc_(alloc), first_(this->InlineFirst()), size_(0), capacity_(InlineCapacity) {
+    assign(count, value);
+  }
+
+  SJTU_CONSTEXPR20 explicit vector(size_t count, const Allocator &alloc = Allocator())
+      : alloc_(alloc), first_(this->InlineFirst()), size_(0), capacity_(InlineCapacity) {
+    Resize(count);
+  }
+
+  /**
+   * constructs the container with the contents of the range [first, last).
+   */
+  template<class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  SJTU_CONSTEXPR20 vector(InputIt first, InputIt last, const Allocator &alloc = Allocator())
+      : alloc_(alloc), first_(this->InlineFirst()), size_(0), capacity_(InlineCapacity) {
+    assign(first, last);
   }
 
   /**
    * Destructor
    */
-  ~vector() {
+  SJTU_CONSTEXPR20 ~vector() {
     Release();
   }
 
   /**
    * Assignment operator
+   * the allocator of other is adopted if the allocator propagates on copy / move assignment.
    */
-  vector &operator=(const vector &other) {
+  SJTU_CONSTEXPR20 vector &operator=(const vector &other) {
     if (this == &other) {
       return *this;
     }
     Release();
-    first_ = alloc_.allocate(other.capacity_);
-    size_ = other.size_;
-    capacity_ = other.capacity_;
-    Copy(first_, other.first_, other.size_);
+    ResetStorage();
+    if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+      alloc_ = other.alloc_;
+    }
+    CopyFrom(other);
+    return *this;
+  }
+
+  SJTU_CONSTEXPR20 vector &operator=(vector &&other) noexcept(
+      (AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value) &&
+      (InlineCapacity == 0 || kNothrowRelocate)) {
+    if (this == &other) {
+      return *this;
+    }
+    Release();
+    ResetStorage();
+    if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+      alloc_ = other.alloc_;
+      StealFrom(other);
+    } else {
+      MoveFrom(other);
+    }
     return *this;
   }
 
+  /**
+   * exchanges the contents with other.
+   * the allocators are exchanged if the allocator propagates on swap.
+   */
+  SJTU_CONSTEXPR20 void swap(vector &other) {
+    if (this == &other) {
+      return;
+    }
+    constexpr bool kPropagate = AllocTraits::propagate_on_container_swap::value;
+    if (!IsInline() && !other.IsInline() && (kPropagate || SameAllocator(other))) {
+      std::swap(first_, other.first_);
+      std::swap(size_, other.size_);
+      std::swap(capacity_, other.capacity_);
+      if constexpr (kPropagate) {
+        std::swap(alloc_, other.alloc_);
+      }
+      return;
+    }
+    vector tmp(std::move(other), other.alloc_);
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+
+  friend SJTU_CONSTEXPR20 void swap(vector &lhs, vector &rhs) {
+    lhs.swap(rhs);
+  }
+
+  /**
+   * returns the allocator associated with the container.
+   */
+  SJTU_CONSTEXPR20 Allocator get_allocator() const {
+    return alloc_;
+  }
+
+  /**
+   * replaces the contents with count copies of value.
+   */
+  SJTU_CONSTEXPR20 void assign(size_t count, const T &value) {
+    T copy(value);
+    Assign(count, [&copy](T *dest) { ConstructAt(dest, copy); });
+  }
+
+  /**
+   * replaces the contents with the elements in [first, last).
+   * the range must not refer to this vector.
+   */
+  template<class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  SJTU_CONSTEXPR20 void assign(InputIt first, InputIt last) {
+    if constexpr (kIsForward<InputIt>) {
+      Assign(std::distance(first, last), [&first](T *dest) {
+        ConstructAt(dest, *first);
+        ++first;
+      });
+    } else {
+      Destroy(first_, size_);
+      size_ = 0;
+      for (; first != last; ++first) {
+        EmplaceAt(size_, *first);
+      }
+    }
+  }
+
   /**
    * assigns specified element with bounds checking
    * throw index_out_of_bound if pos is not in [0, size)
    */
-  T &at(const size_t &pos) {
+  SJTU_CONSTEXPR20 T &at(const size_t &pos) {
     if (pos >= size_) {
       throw index_out_of_bound();
     }
     return first_[pos];
   }
 
-  const T &at(const size_t &pos) const {
+  SJTU_CONSTEXPR20 const T &at(const size_t &pos) const {
     if (pos >= size_) {
       throw index_out_of_bound();
     }
@@ -295,14 +681,14 @@ public:
    * !!! Pay attentions
    *   In STL this operator does not check the boundary but I want you to do.
    */
-  T &operator[](const size_t &pos) {
+  SJTU_CONSTEXPR20 T &operator[](const size_t &pos) {
     if (pos >= size_) {
       throw index_out_of_bound();
     }
     return first_[pos];
   }
 
-  const T &operator[](const size_t &pos) const {
+  SJTU_CONSTEXPR20 const T &operator[](const size_t &pos) const {
     if (pos >= size_) {
       throw index_out_of_bound();
     }
@@ -313,7 +699,7 @@ public:
    * access the first element.
    * throw container_is_empty if size == 0
    */
-  const T &front() const {
+  SJTU_CONSTEXPR20 const T &front() const {
     if (size_ == 0) {
       throw container_is_empty();
     }
@@ -324,7 +710,7 @@ public:
    * access the last element.
    * throw container_is_empty if size == 0
    */
-  const T &back() const {
+  SJTU_CONSTEXPR20 const T &back() const {
     if (size_ == 0) {
       throw container_is_empty();
     }
@@ -334,85 +720,176 @@ public:
   /**
    * returns an iterator to the beginning.
    */
-  iterator begin() {
+  SJTU_CONSTEXPR20 iterator begin() {
+    return {first_, this};
+  }
+
+  SJTU_CONSTEXPR20 const_iterator begin() const {
     return {first_, this};
   }
 
-  const_iterator cbegin() const {
+  SJTU_CONSTEXPR20 const_iterator cbegin() const {
     return {first_, this};
   }
 
   /**
    * returns an iterator to the end.
    */
-  iterator end() {
+  SJTU_CONSTEXPR20 iterator end() {
     return {first_ + size_, this};
   }
 
-  const_iterator cend() const {
+  SJTU_CONSTEXPR20 const_iterator end() const {
     return {first_ + size_, this};
   }
 
+  SJTU_CONSTEXPR20 const_iterator cend() const {
+    return {first_ + size_, this};
+  }
+
+  /**
+   * returns a pointer to the underlying array, so that [data(), data() + size()) is a valid range.
+   */
+  SJTU_CONSTEXPR20 T *data() {
+    return first_;
+  }
+
+  SJTU_CONSTEXPR20 const T *data() const {
+    return first_;
+  }
+
   /**
    * checks whether the container is empty
    */
-  bool empty() const {
+  SJTU_CONSTEXPR20 bool empty() const {
     return size_ == 0;
   }
 
   /**
    * returns the number of elements
    */
-  size_t size() const {
+  SJTU_CONSTEXPR20 size_t size() const {
     return size_;
   }
 
   /**
-   * clears the contents
+   * returns the number of elements that can be held in currently allocated storage
+   */
+  SJTU_CONSTEXPR20 size_t capacity() const {
+    return capacity_;
+  }
+
+  /**
+   * increases the capacity to at least new_cap. does nothing if new_cap <= capacity().
+   */
+  SJTU_CONSTEXPR20 void reserve(size_t new_cap) {
+    if (new_cap > capacity_) {
+      Reallocate(new_cap);
+    }
+  }
+
+  /**
+   * resizes the container to contain count elements.
+   * additional elements are value-initialized, or copies of value.
+   * the capacity is never reduced.
+   */
+  SJTU_CONSTEXPR20 void resize(size_t count) {
+    Resize(count);
+  }
+
+  SJTU_CONSTEXPR20 void resize(size_t count, const T &value) {
+    Resize(count, value);
+  }
+
+  /**
+   * reduces the capacity to size().
+   */
+  SJTU_CONSTEXPR20 void shrink_to_fit() {
+    if (size_ == capacity_ || IsInline()) {
+      return;
+    }
+    if (size_ == 0) {
+      Release();
+      ResetStorage();
+      return;
+    }
+    Reallocate(size_);
+  }
+
+  /**
+   * clears the contents and frees the storage
    */
-  void clear() {
+  SJTU_CONSTEXPR20 void clear() {
     Release();
-    first_ = alloc_.allocate(minCapacity);
-    size_ = 0;
-    capacity_ = minCapacity;
+    ResetStorage();
   }
 
   /**
    * inserts value before pos
    * returns an iterator pointing to the inserted value.
    */
-  iterator insert(iterator pos, const T &value) {
+  SJTU_CONSTEXPR20 iterator insert(iterator pos, const T &value) {
     return insert(pos - begin(), value);
   }
 
+  SJTU_CONSTEXPR20 iterator insert(iterator pos, T &&value) {
+    return insert(pos - begin(), std::move(value));
+  }
+
   /**
    * inserts value at index ind.
    * after inserting, this->at(ind) == value
    * returns an iterator pointing to the inserted value.
    * throw index_out_of_bound if ind > size (in this situation ind can be size because after inserting the size will increase 1.)
    */
-  iterator insert(const size_t &ind, const T &value) {
-    if (ind > size_) {
-      throw index_out_of_bound();
-    }
-    if (size_ < capacity_ - 1) {
-      new (first_ + size_) T(value);
-      for (int i = size_; i > ind; i--) {
-        first_[i] = first_[i - 1];
-      }
-      first_[ind] = value;
-      size_++;
+  SJTU_CONSTEXPR20 iterator insert(const size_t &ind, const T &value) {
+    return EmplaceAt(ind, value);
+  }
+
+  SJTU_CONSTEXPR20 iterator insert(const size_t &ind, T &&value) {
+    return EmplaceAt(ind, std::move(value));
+  }
+
+  /**
+   * inserts count copies of value before pos, or at index ind.
+   * the tail is shifted once and the storage is reallocated at most once.
+   * returns an iterator pointing to the first inserted element, or pos if count == 0.
+   * throw index_out_of_bound if ind > size
+   */
+  SJTU_CONSTEXPR20 iterator insert(iterator pos, size_t count, const T &value) {
+    return insert(pos - begin(), count, value);
+  }
+
+  SJTU_CONSTEXPR20 iterator insert(const size_t &ind, size_t count, const T &value) {
+    T copy(value);
+    return InsertN(ind, count, [&copy](T *dest) { ConstructAt(dest, copy); });
+  }
+
+  /**
+   * inserts the elements in [first, last) before pos, or at index ind.
+   * the range must not refer to this vector.
+   * returns an iterator pointing to the first inserted element, or pos if first == last.
+   * throw index_out_of_bound if ind > size
+   */
+  template<class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  SJTU_CONSTEXPR20 iterator insert(iterator pos, InputIt first, InputIt last) {
+    return insert(pos - begin(), first, last);
+  }
+
+  template<class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  SJTU_CONSTEXPR20 iterator insert(const size_t &ind, InputIt first, InputIt last) {
+    if constexpr (kIsForward<InputIt>) {
+      return InsertN(ind, std::distance(first, last), [&first](T *dest) {
+        ConstructAt(dest, *first);
+        ++first;
+      });
     } else {
-      T *new_space = alloc_.allocate(2 * capacity_);
-      Copy(new_space, first_, ind);
-      new(new_space + ind) T(value);
-      Copy(new_space + ind + 1, first_ + ind, size_ - ind);
-      Release();
-      first_ = new_space;
-      size_++;
-      capacity_ *= 2;
+      // the length of a single-pass range is unknown, so buffer it first.
+      vector buffer(first, last, alloc_);
+      size_t i = 0;
+      return InsertN(ind, buffer.size_,
+                     [&buffer, &i](T *dest) { ConstructAt(dest, std::move(buffer.first_[i++])); });
     }
-    return {first_ + ind, this};
   }
 
   /**
@@ -420,7 +897,7 @@ public:
    * return an iterator pointing to the following element.
    * If the iterator pos refers the last element, the end() iterator is returned.
    */
-  iterator erase(iterator pos) {
+  SJTU_CONSTEXPR20 iterator erase(iterator pos) {
     return erase(pos - begin());
   }
 
@@ -429,68 +906,1406 @@ public:
    * return an iterator pointing to the following element.
    * throw index_out_of_bound if ind >= size
    */
-  iterator erase(const size_t &ind) {
+  SJTU_CONSTEXPR20 iterator erase(const size_t &ind) {
     if (ind >= size_) {
       throw index_out_of_bound();
     }
-    if (capacity_ > minCapacity && size_ + 1 <= capacity_ / 4) {
-      size_t new_capacity = std::max(capacity_ / 4, minCapacity);
-      T *new_space = alloc_.allocate(new_capacity);
-      Copy(new_space, first_, ind);
-      Copy(new_space + ind, first_ + ind + 1, size_ - 1 - ind);
-      Release();
-      first_ = new_space;
-      size_--;
-      capacity_ = new_capacity;
-    } else {
-      for (int i = ind; i + 2 <= size_; i++) {
-        new(first_ + i) T(first_[i + 1]);
-      }
-      (first_ + size_ - 1)->~T();
-      size_--;
+    return EraseN(ind, 1);
+  }
+
+  /**
+   * removes the elements in [first, last).
+   * return an iterator pointing to the element following the removed ones.
+   * throw index_out_of_bound if first > last or last > size
+   */
+  SJTU_CONSTEXPR20 iterator erase(iterator first, iterator last) {
+    return erase(static_cast<size_t>(first - begin()), static_cast<size_t>(last - begin()));
+  }
+
+  SJTU_CONSTEXPR20 iterator erase(const size_t &first, const size_t &last) {
+    if (first > last || last > size_) {
+      throw index_out_of_bound();
     }
-    return {first_ + ind, this};
+    return EraseN(first, last - first);
   }
 
   /**
    * adds an element to the end.
    */
-  void push_back(const T &value) {
-    insert(size_, value);
+  SJTU_CONSTEXPR20 void push_back(const T &value) {
+    EmplaceAt(size_, value);
+  }
+
+  SJTU_CONSTEXPR20 void push_back(T &&value) {
+    EmplaceAt(size_, std::move(value));
+  }
+
+  /**
+   * constructs an element in place at the end.
+   * returns a reference to the new element.
+   */
+  template<class... Args>
+  SJTU_CONSTEXPR20 T &emplace_back(Args &&... args) {
+    return *EmplaceAt(size_, std::forward<Args>(args)...);
   }
 
   /**
    * remove the last element from the end.
    * throw container_is_empty if size() == 0
    */
-  void pop_back() {
+  SJTU_CONSTEXPR20 void pop_back() {
     if (size_ == 0) {
       throw container_is_empty();
     }
     erase(size_ - 1);
   }
 
-private:
-  static const size_t minCapacity;
+  /**
+   * writes the vector in a binary format: a 16-byte header (magic, element size, element count) and then
+   *   the elements. a trivially copyable T is written as the raw buffer in a single write call; other types
+   *   are written one by one through serializer<T>.
+   * throw runtime_error if the stream fails.
+   */
+  void save(std::ostream &os) const {
+    StreamWriter writer{os};
+    SaveTo(writer);
+  }
 
-  Allocator alloc_;
-  T *first_;
-  size_t size_, capacity_;
+  void save(std::FILE *fp) const {
+    FileWriter writer{fp};
+    SaveTo(writer);
+  }
 
-  void Release() {
-    for (int i = 0; i < size_; i++) {
-      (first_ + i)->~T();
-    }
-    alloc_.deallocate(first_, capacity_);
+  /**
+   * replaces the contents with a vector written by save().
+   * for a trivially copyable T the storage is allocated for exactly the stored count and filled with a single
+   *   read call.
+   * throw runtime_error if the stream fails, holds a different type or a count above what the allocator can
+   *   provide; the vector is left empty then.
+   */
+  void load(std::istream &is) {
+    StreamReader reader{is};
+    LoadFrom(reader);
   }
-  void Copy(T *dest, T *src, size_t n) {
-    for (int i = 0; i < n; i++) {
-      new(dest + i) T(src[i]);
-    }
+
+  void load(std::FILE *fp) {
+    FileReader reader{fp};
+    LoadFrom(reader);
   }
-};
 
-template<typename T, typename Allocator> const size_t vector<T, Allocator>::minCapacity = 8;
+  /**
+   * returns the counters of this vector since its construction or the last reset_stats().
+   * they are only kept when SJTU_CONTAINER_STATS is defined; otherwise they are all 0 and cost nothing.
+   * the counters stay with the object: they are neither copied, moved nor swapped with the contents.
+   */
+  SJTU_CONSTEXPR20 vector_stats stats() const {
+#ifdef SJTU_CONTAINER_STATS
+    return stats_;
+#else
+    return vector_stats();
+#endif
+  }
+
+  SJTU_CONSTEXPR20 void reset_stats() {
+#ifdef SJTU_CONTAINER_STATS
+    stats_ = vector_stats();
+#endif
+  }
+
+private:
+  static const size_t minCapacity;
+
+  Allocator alloc_;
+  T *first_;
+  size_t size_, capacity_;
+#ifdef SJTU_CONTAINER_STATS
+  vector_stats stats_;
+#endif
+
+  using AllocTraits = std::allocator_traits<Allocator>;
+
+  static constexpr bool kRelocatable = is_trivially_relocatable<T>::value;
+  // whether elements can be moved into raw storage without the risk of an exception.
+  static constexpr bool kNothrowRelocate = kRelocatable || std::is_nothrow_move_constructible<T>::value;
+
+  // whether a full buffer is grown by the allocator itself instead of allocate + relocate + deallocate.
+  static constexpr bool kReallocateInPlace = kRelocatable && has_reallocate<Allocator, T>::value;
+
+  template<class It>
+  static constexpr bool kIsForward =
+      std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value;
+
+  // whether the call is being evaluated at compile time, where the bytewise copies below are not allowed.
+  static constexpr bool ConstantEvaluated() {
+#if __cplusplus >= 202002L
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
+  }
+
+  // construct an element in the raw storage at p, in a way that is usable in constant evaluation under C++20.
+  template<class... Args>
+  static SJTU_CONSTEXPR20 void ConstructAt(T *p, Args &&... args) {
+#if __cplusplus >= 202002L
+    std::construct_at(p, std::forward<Args>(args)...);
+#else
+    new(p) T(std::forward<Args>(args)...);
+#endif
+  }
+
+  static SJTU_CONSTEXPR20 void Destroy(T *first, size_t n) {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+      for (size_t i = 0; i < n; i++) {
+        (first + i)->~T();
+      }
+    }
+  }
+
+  SJTU_CONSTEXPR20 bool IsInline() const {
+    return InlineCapacity != 0 && first_ == this->InlineFirst();
+  }
+
+  // record a new buffer of `capacity` elements / n elements copied or moved into stats_.
+  // they do nothing unless SJTU_CONTAINER_STATS is defined.
+  SJTU_CONSTEXPR20 void CountBuffer([[maybe_unused]] size_t capacity) {
+#ifdef SJTU_CONTAINER_STATS
+    stats_.reallocations++;
+    if (capacity > stats_.peak_capacity) {
+      stats_.peak_capacity = capacity;
+    }
+#endif
+  }
+
+  SJTU_CONSTEXPR20 void CountCopied([[maybe_unused]] size_t n) {
+#ifdef SJTU_CONTAINER_STATS
+    stats_.bytes_copied += n * sizeof(T);
+#endif
+  }
+
+  // return storage for at least `capacity` elements other than the current buffer.
+  // the inline buffer is chosen when it is large enough and not in use; `capacity` is updated to match.
+  SJTU_CONSTEXPR20 T *Allocate(size_t &capacity) {
+    if (InlineCapacity != 0 && capacity <= InlineCapacity && !IsInline()) {
+      capacity = InlineCapacity;
+      CountBuffer(capacity);
+      return this->InlineFirst();
+    }
+    T *res = AllocTraits::allocate(alloc_, capacity);
+    CountBuffer(capacity);
+    return res;
+  }
+
+  SJTU_CONSTEXPR20 void Deallocate(T *first, size_t capacity) {
+    if (first != nullptr && (InlineCapacity == 0 || first != this->InlineFirst())) {
+      AllocTraits::deallocate(alloc_, first, capacity);
+    }
+  }
+
+  // point at the empty inline buffer (or at nothing); the old buffer must have been released.
+  SJTU_CONSTEXPR20 void ResetStorage() {
+    first_ = this->InlineFirst();
+    size_ = 0;
+    capacity_ = InlineCapacity;
+  }
+
+  SJTU_CONSTEXPR20 void Release() {
+    Destroy(first_, size_);
+    Deallocate(first_, capacity_);
+  }
+
+  // free the old buffer after its elements have been relocated by Relocate().
+  SJTU_CONSTEXPR20 void ReleaseRelocated() {
+    if constexpr (!kRelocatable) {
+      Destroy(first_, size_);
+    }
+    Deallocate(first_, capacity_);
+  }
+
+  SJTU_CONSTEXPR20 bool SameAllocator(const vector &other) const {
+    if constexpr (AllocTraits::is_always_equal::value) {
+      return true;
+    } else {
+      return alloc_ == other.alloc_;
+    }
+  }
+
+  // copy the elements of other into this empty vector, keeping the capacity of other.
+  SJTU_CONSTEXPR20 void CopyFrom(const vector &other) {
+    if (other.capacity_ > capacity_) {
+      size_t new_capacity = other.capacity_;
+      first_ = Allocate(new_capacity);
+      capacity_ = new_capacity;
+    }
+    Copy(first_, other.first_, other.size_);
+    size_ = other.size_;
+  }
+
+  // move the elements of other into this empty vector and leave other empty, taking over its buffer only if
+  // alloc_ is able to free it.
+  SJTU_CONSTEXPR20 void MoveFrom(vector &other) {
+    if (SameAllocator(other)) {
+      StealFrom(other);
+      return;
+    }
+    assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+    other.clear();
+  }
+
+  // take the elements of other into this empty vector and leave other empty.
+  // a heap buffer is taken over; elements in the inline buffer of other have to be moved one by one.
+  SJTU_CONSTEXPR20 void StealFrom(vector &other) {
+    if (!other.IsInline()) {
+      first_ = other.first_;
+      size_ = other.size_;
+      capacity_ = other.capacity_;
+      other.ResetStorage();
+      return;
+    }
+    if constexpr (kNothrowRelocate) {
+      MoveRange(first_, other.first_, other.size_);
+    } else {
+      Relocate(first_, other.first_, other.size_);
+      Destroy(other.first_, other.size_);
+    }
+    size_ = other.size_;
+    other.size_ = 0;
+  }
+
+  SJTU_CONSTEXPR20 void Copy(T *dest, const T *src, size_t n) {
+    CountCopied(n);
+    if constexpr (std::is_trivially_copyable<T>::value) {
+      if (!ConstantEvaluated()) {
+        if (n != 0) {
+          std::memcpy(static_cast<void *>(dest), static_cast<const void *>(src), n * sizeof(T));
+        }
+        return;
+      }
+    }
+    for (size_t i = 0; i < n; i++) {
+      ConstructAt(dest + i, src[i]);
+    }
+  }
+
+  // construct n elements in the raw storage at dest from src.
+  // trivially relocatable elements are copied bytewise; otherwise they are moved if T has a noexcept move
+  // constructor and copied if not. src is left for ReleaseRelocated() to destroy.
+  // if a copy throws, the elements already built at dest are destroyed and src is intact.
+  // in constant evaluation relocatable elements are moved and destroyed one by one instead.
+  SJTU_CONSTEXPR20 void Relocate(T *dest, T *src, size_t n) {
+    CountCopied(n);
+    if constexpr (kRelocatable) {
+      if (!ConstantEvaluated()) {
+        if (n != 0) {
+          std::memcpy(static_cast<void *>(dest), static_cast<const void *>(src), n * sizeof(T));
+        }
+        return;
+      }
+    }
+    size_t i = 0;
+    try {
+      for (; i < n; i++) {
+        ConstructAt(dest + i, std::move_if_noexcept(src[i]));
+      }
+    } catch (...) {
+      Destroy(dest, i);
+      throw;
+    }
+    if constexpr (kRelocatable) {
+      Destroy(src, n);
+    }
+  }
+
+  // overwrite the live element at dest with src.
+  // a noexcept move constructor is preferred to move assignment so that types whose move assignment does not
+  // release the old resource (e.g. Util::Bint) do not leak.
+  SJTU_CONSTEXPR20 void Shift(T *dest, T *src) {
+    CountCopied(1);
+    if constexpr (std::is_nothrow_move_constructible<T>::value) {
+      dest->~T();
+      ConstructAt(dest, std::move(*src));
+    } else {
+      *dest = *src;
+    }
+  }
+
+  // make new_space, which already holds n new elements at [ind, ind + n), the buffer: the elements before ind are
+  // relocated in front of the new ones and the rest after them.
+  // if relocating an element throws, everything built in new_space is destroyed, new_space is freed and the
+  // vector is left unchanged.
+  SJTU_CONSTEXPR20 void AdoptBuffer(T *new_space, size_t new_capacity, size_t ind, size_t n) {
+    try {
+      Relocate(new_space, first_, ind);
+      try {
+        Relocate(new_space + ind + n, first_ + ind, size_ - ind);
+      } catch (...) {
+        Destroy(new_space, ind);
+        throw;
+      }
+    } catch (...) {
+      Destroy(new_space + ind, n);
+      Deallocate(new_space, new_capacity);
+      throw;
+    }
+    ReleaseRelocated();
+    first_ = new_space;
+    size_ += n;
+    capacity_ = new_capacity;
+  }
+
+  SJTU_CONSTEXPR20 size_t GrowCapacity(size_t required) const {
+    size_t res = GrowthPolicy().grow(capacity_, required);
+    return res < minCapacity ? minCapacity : res;
+  }
+
+  // move the n elements at src to the raw storage at dest, leaving src as raw storage. the ranges may overlap.
+  // only used when kNothrowRelocate holds.
+  SJTU_CONSTEXPR20 void MoveRange(T *dest, T *src, size_t n) {
+    CountCopied(n);
+    if constexpr (kRelocatable) {
+      if (!ConstantEvaluated()) {
+        // no vector holds more than PTRDIFF_MAX bytes. stating it keeps gcc from warning about the wrapped
+        // lengths of paths the callers' index checks exclude, e.g. insert(size() + 1, ...) with size() == SIZE_MAX.
+        if (n > PTRDIFF_MAX / sizeof(T)) {
+          __builtin_unreachable();
+        }
+        std::memmove(static_cast<void *>(dest), static_cast<const void *>(src), n * sizeof(T));
+        return;
+      }
+    }
+    if (dest < src) {
+      for (size_t i = 0; i < n; i++) {
+        ConstructAt(dest + i, std::move(src[i]));
+        (src + i)->~T();
+      }
+    } else {
+      for (size_t i = n; i-- > 0;) {
+        ConstructAt(dest + i, std::move(src[i]));
+        (src + i)->~T();
+      }
+    }
+  }
+
+  // construct n elements at dest by calling construct(p) for each raw slot p in order.
+  // if one of them throws, the elements already constructed are destroyed.
+  template<class Construct>
+  static SJTU_CONSTEXPR20 void ConstructN(T *dest, size_t n, Construct &construct) {
+    size_t i = 0;
+    try {
+      for (; i < n; i++) {
+        construct(dest + i);
+      }
+    } catch (...) {
+      Destroy(dest, i);
+      throw;
+    }
+  }
+
+  // insert n elements built by construct at index ind: the tail is shifted once and the storage is reallocated
+  // at most once.
+  template<class Construct>
+  SJTU_CONSTEXPR20 iterator InsertN(size_t ind, size_t n, Construct construct) {
+    if (ind > size_) {
+      throw index_out_of_bound();
+    }
+    if (n == 0) {
+      return {first_ + ind, this};
+    }
+    if constexpr (kReallocateInPlace) {
+      if (size_ + n > capacity_) {
+        Reallocate(GrowCapacity(size_ + n));
+      }
+    }
+    if constexpr (kNothrowRelocate) {
+      if (size_ + n <= capacity_) {
+        MoveRange(first_ + ind + n, first_ + ind, size_ - ind);
+        try {
+          ConstructN(first_ + ind, n, construct);
+        } catch (...) {
+          MoveRange(first_ + ind, first_ + ind + n, size_ - ind);
+          throw;
+        }
+        size_ += n;
+        return {first_ + ind, this};
+      }
+    }
+    // the new elements are built before the old ones are relocated, since they may be copies of them. if either
+    // step throws, the new buffer is freed and the vector is unchanged.
+    size_t new_capacity = (size_ + n <= capacity_ ? capacity_ : GrowCapacity(size_ + n));
+    T *new_space = Allocate(new_capacity);
+    try {
+      ConstructN(new_space + ind, n, construct);
+    } catch (...) {
+      Deallocate(new_space, new_capacity);
+      throw;
+    }
+    AdoptBuffer(new_space, new_capacity, ind, n);
+    return {first_ + ind, this};
+  }
+
+  // remove the n elements starting at index ind, shifting the tail once.
+  SJTU_CONSTEXPR20 iterator EraseN(size_t ind, size_t n) {
+    if (n == 0) {
+      return {first_ + ind, this};
+    }
+    if constexpr (kNothrowRelocate) {
+      Destroy(first_ + ind, n);
+      MoveRange(first_ + ind, first_ + ind + n, size_ - ind - n);
+    } else {
+      for (size_t i = ind; i + n < size_; i++) {
+        Shift(first_ + i, first_ + i + n);
+      }
+      Destroy(first_ + size_ - n, n);
+    }
+    size_ -= n;
+    size_t new_capacity = GrowthPolicy().shrink(size_, capacity_);
+    if (new_capacity < minCapacity) {
+      new_capacity = minCapacity;
+    }
+    if (new_capacity < capacity_ && new_capacity >= size_) {
+      Reallocate(new_capacity);
+    }
+    return {first_ + ind, this};
+  }
+
+  // replace the contents with n elements built by construct, allocating only if n exceeds the capacity.
+  template<class Construct>
+  SJTU_CONSTEXPR20 void Assign(size_t n, Construct construct) {
+    if (n > capacity_) {
+      size_t new_capacity = n;
+      T *new_space = Allocate(new_capacity);
+      try {
+        ConstructN(new_space, n, construct);
+      } catch (...) {
+        Deallocate(new_space, new_capacity);
+        throw;
+      }
+      Release();
+      first_ = new_space;
+      size_ = n;
+      capacity_ = new_capacity;
+      return;
+    }
+    Destroy(first_, size_);
+    size_ = 0;
+    ConstructN(first_, n, construct);
+    size_ = n;
+  }
+
+  struct BinaryHeader {
+    char magic_[4];
+    uint32_t element_size_;  // sizeof(T) for the raw format, 0 for serializer<T>
+    uint64_t size_;
+  };
+
+  struct StreamWriter {
+    std::ostream &os_;
+
+    void write(const void *src, size_t n) {
+      if (!os_.write(static_cast<const char *>(src), static_cast<std::streamsize>(n))) {
+        throw runtime_error();
+      }
+    }
+  };
+
+  struct FileWriter {
+    std::FILE *fp_;
+
+    void write(const void *src, size_t n) {
+      if (n != 0 && std::fwrite(src, 1, n, fp_) != n) {
+        throw runtime_error();
+      }
+    }
+  };
+
+  struct StreamReader {
+    std::istream &is_;
+
+    void read(void *dest, size_t n) {
+      if (!is_.read(static_cast<char *>(dest), static_cast<std::streamsize>(n))) {
+        throw runtime_error();
+      }
+    }
+  };
+
+  struct FileReader {
+    std::FILE *fp_;
+
+    void read(void *dest, size_t n) {
+      if (n != 0 && std::fread(dest, 1, n, fp_) != n) {
+        throw runtime_error();
+      }
+    }
+  };
+
+  template<class Writer>
+  void SaveTo(Writer &out) const {
+    constexpr bool kRaw = std::is_trivially_copyable<T>::value;
+    BinaryHeader header{{'S', 'J', 'V', '1'}, kRaw ? static_cast<uint32_t>(sizeof(T)) : 0, size_};
+    out.write(&header, sizeof(header));
+    if constexpr (kRaw) {
+      out.write(first_, size_ * sizeof(T));
+    } else {
+      for (size_t i = 0; i < size_; i++) {
+        serializer<T>::save(out, first_[i]);
+      }
+    }
+  }
+
+  template<class Reader>
+  void LoadFrom(Reader &in) {
+    constexpr bool kRaw = std::is_trivially_copyable<T>::value;
+    Release();
+    ResetStorage();
+    BinaryHeader header;
+    in.read(&header, sizeof(header));
+    if (std::memcmp(header.magic_, "SJV1", 4) != 0 || header.element_size_ != (kRaw ? sizeof(T) : 0)) {
+      throw runtime_error();
+    }
+    if (header.size_ > AllocTraits::max_size(alloc_)) {
+      throw runtime_error();
+    }
+    if (header.size_ == 0) {
+      return;
+    }
+    if constexpr (kRaw) {
+      size_t new_capacity = header.size_;
+      T *new_space = Allocate(new_capacity);
+      try {
+        in.read(new_space, header.size_ * sizeof(T));
+      } catch (...) {
+        Deallocate(new_space, new_capacity);
+        throw;
+      }
+      first_ = new_space;
+      size_ = header.size_;
+      capacity_ = new_capacity;
+    } else {
+      reserve(header.size_);
+      try {
+        for (uint64_t i = 0; i < header.size_; i++) {
+          EmplaceAt(size_, serializer<T>::load(in));
+        }
+      } catch (...) {
+        clear();
+        throw;
+      }
+    }
+  }
+
+  SJTU_CONSTEXPR20 void Reallocate(size_t new_capacity) {
+    if (new_capacity <= InlineCapacity && IsInline()) {
+      return;
+    }
+    if constexpr (kReallocateInPlace) {
+      if (first_ != nullptr && !IsInline() && new_capacity > InlineCapacity) {
+        first_ = alloc_.reallocate(first_, capacity_, new_capacity);
+        capacity_ = new_capacity;
+        CountBuffer(new_capacity);
+        return;
+      }
+    }
+    T *new_space = Allocate(new_capacity);
+    AdoptBuffer(new_space, new_capacity, size_, 0);
+  }
+
+  template<class... Args>
+  SJTU_CONSTEXPR20 void Resize(size_t count, const Args &... args) {
+    if (count <= size_) {
+      Destroy(first_ + count, size_ - count);
+      size_ = count;
+      return;
+    }
+    if (count <= capacity_) {
+      for (; size_ < count; size_++) {
+        ConstructAt(first_ + size_, args...);
+      }
+      return;
+    }
+    if constexpr (kReallocateInPlace) {
+      T value(args...);
+      Reallocate(GrowCapacity(count));
+      for (; size_ < count; size_++) {
+        ConstructAt(first_ + size_, value);
+      }
+      return;
+    }
+    // args may refer to an element of this vector, so construct the new elements before relocating the old ones.
+    size_t new_capacity = GrowCapacity(count);
+    T *new_space = Allocate(new_capacity);
+    size_t i = size_;
+    try {
+      for (; i < count; i++) {
+        ConstructAt(new_space + i, args...);
+      }
+    } catch (...) {
+      Destroy(new_space + size_, i - size_);
+      Deallocate(new_space, new_capacity);
+      throw;
+    }
+    AdoptBuffer(new_space, new_capacity, size_, count - size_);
+  }
+
+  template<class... Args>
+  SJTU_CONSTEXPR20 iterator EmplaceAt(size_t ind, Args &&... args) {
+    if (ind > size_) {
+      throw index_out_of_bound();
+    }
+    if (size_ < capacity_) {
+      if (ind == size_) {
+        ConstructAt(first_ + size_, std::forward<Args>(args)...);
+      } else {
+        // args may refer to an element of this vector, so build the value before shifting.
+        T value(std::forward<Args>(args)...);
+        if constexpr (kRelocatable) {
+          MoveRange(first_ + ind + 1, first_ + ind, size_ - ind);
+          ConstructAt(first_ + ind, std::move(value));
+        } else {
+          // the new last element is counted at once, so that a throwing assignment below does not leak it.
+          ConstructAt(first_ + size_, std::move_if_noexcept(first_[size_ - 1]));
+          size_++;
+          for (size_t i = size_ - 2; i > ind; i--) {
+            Shift(first_ + i, first_ + i - 1);
+          }
+          Shift(first_ + ind, &value);
+          return {first_ + ind, this};
+        }
+      }
+      size_++;
+    } else if constexpr (kReallocateInPlace) {
+      // args may refer to an element of this vector, which may move with the buffer.
+      T value(std::forward<Args>(args)...);
+      Reallocate(GrowCapacity(size_ + 1));
+      return EmplaceAt(ind, std::move(value));
+    } else {
+      size_t new_capacity = GrowCapacity(size_ + 1);
+      T *new_space = Allocate(new_capacity);
+      try {
+        ConstructAt(new_space + ind, std::forward<Args>(args)...);
+      } catch (...) {
+        Deallocate(new_space, new_capacity);
+        throw;
+      }
+      AdoptBuffer(new_space, new_capacity, ind, 1);
+    }
+    return {first_ + ind, this};
+  }
+};
+
+template<typename T, typename Allocator, typename GrowthPolicy, size_t InlineCapacity>
+const size_t vector<T, Allocator, GrowthPolicy, InlineCapacity>::minCapacity = 8;
+
+/**
+ * a vector keeping up to N elements inside the object, which only allocates when it grows beyond N.
+ * it has the same interface as vector.
+ */
+template<typename T, size_t N, typename Allocator = default_allocator<T>, typename GrowthPolicy = double_growth>
+using small_vector = vector<T, Allocator, GrowthPolicy, N>;
+
+/**
+ * an allocator without memory: allocate() throws runtime_error.
+ * a vector using it never touches the heap and can only hold what fits in its inline buffer.
+ */
+template<typename T>
+class null_allocator {
+public:
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  null_allocator() = default;
+
+  template<typename U>
+  null_allocator(const null_allocator<U> &) {}
+
+  T *allocate(size_t) {
+    throw runtime_error();
+  }
+
+  void deallocate(T *, size_t) {}
+
+  template<typename U>
+  bool operator==(const null_allocator<U> &) const {
+    return true;
+  }
+
+  template<typename U>
+  bool operator!=(const null_allocator<U> &) const {
+    return false;
+  }
+};
+
+/**
+ * a vector of at most N elements stored inside the object, which never allocates.
+ * it has the same interface as vector; anything that would need more than N elements throws runtime_error
+ *   and leaves the container unchanged. the elements need not be default constructible.
+ * static_vector<bool, N> packs its flags, so it holds N rounded up to a multiple of 64.
+ */
+template<typename T, size_t N>
+using static_vector = vector<T, null_allocator<T>, double_growth_no_shrink, N>;
+
+/**
+ * vector<bool> packs its flags into 64-bit words, 8 times smaller than one byte per flag.
+ * elements are reached through a proxy reference; there is no data().
+ * besides the usual interface it has word-at-a-time bulk operations: count(), find_first() / find_next(),
+ *   flip(), and &=, |=, ^= between vectors of the same size, which the compiler vectorizes.
+ * the words are kept in a vector<uint64_t> with the same allocator and growth policy; the bits past size()
+ *   in the last word are always zero.
+ */
+template<typename Allocator, typename GrowthPolicy, size_t InlineCapacity>
+class vector<bool, Allocator, GrowthPolicy, InlineCapacity> {
+  using Word = uint64_t;
+  using WordAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Word>;
+  using Words = vector<Word, WordAllocator, GrowthPolicy, (InlineCapacity + 63) / 64>;
+
+  static const size_t kWordBits = 64;
+
+public:
+  /**
+   * stands for one flag: converts to bool, and assigning to it sets the flag.
+   */
+  class reference {
+  public:
+    reference(const reference &other) = default;
+
+    SJTU_CONSTEXPR20 operator bool() const {
+      return (*word_ & mask_) != 0;
+    }
+
+    SJTU_CONSTEXPR20 reference &operator=(bool value) {
+      if (value) {
+        *word_ |= mask_;
+      } else {
+        *word_ &= ~mask_;
+      }
+      return *this;
+    }
+
+    SJTU_CONSTEXPR20 reference &operator=(const reference &other) {
+      return *this = static_cast<bool>(other);
+    }
+
+    SJTU_CONSTEXPR20 void flip() {
+      *word_ ^= mask_;
+    }
+
+  private:
+    friend class vector;
+
+    SJTU_CONSTEXPR20 reference(Word *word, Word mask) : word_(word), mask_(mask) {}
+
+    Word *word_;
+    Word mask_;
+  };
+
+private:
+  template<bool Const>
+  class Iterator {
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = bool;
+    using reference = std::conditional_t<Const, bool, typename vector::reference>;
+    using pointer = void;
+    using iterator_category = std::random_access_iterator_tag;
+
+  private:
+    friend class vector;
+    friend class Iterator<!Const>;
+
+    using Container = std::conditional_t<Const, const vector, vector>;
+
+    Container *vec_ptr_;
+    size_t index_;
+
+    SJTU_CONSTEXPR20 Iterator(Container *vec_ptr, size_t index) : vec_ptr_(vec_ptr), index_(index) {}
+
+  public:
+    SJTU_CONSTEXPR20 Iterator() : vec_ptr_(nullptr), index_(0) {}
+
+    template<bool OtherConst, class = std::enable_if_t<Const && !OtherConst>>
+    SJTU_CONSTEXPR20 Iterator(const Iterator<OtherConst> &other) : vec_ptr_(other.vec_ptr_), index_(other.index_) {}
+
+    SJTU_CONSTEXPR20 Iterator operator+(difference_type n) const {
+      return {vec_ptr_, index_ + n};
+    }
+
+    friend SJTU_CONSTEXPR20 Iterator operator+(difference_type n, const Iterator &it) {
+      return it + n;
+    }
+
+    SJTU_CONSTEXPR20 Iterator operator-(difference_type n) const {
+      return {vec_ptr_, index_ - n};
+    }
+
+    // if these two iterators point to different vectors, throw invaild_iterator.
+    SJTU_CONSTEXPR20 difference_type operator-(const Iterator &rhs) const {
+      if (vec_ptr_ != rhs.vec_ptr_) {
+        throw invalid_iterator();
+      }
+      return static_cast<difference_type>(index_ - rhs.index_);
+    }
+
+    SJTU_CONSTEXPR20 Iterator &operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+
+    SJTU_CONSTEXPR20 Iterator &operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+
+    SJTU_CONSTEXPR20 Iterator operator++(int) {
+      Iterator old = *this;
+      ++index_;
+      return old;
+    }
+
+    SJTU_CONSTEXPR20 Iterator &operator++() {
+      ++index_;
+      return *this;
+    }
+
+    SJTU_CONSTEXPR20 Iterator operator--(int) {
+      Iterator old = *this;
+      --index_;
+      return old;
+    }
+
+    SJTU_CONSTEXPR20 Iterator &operator--() {
+      --index_;
+      return *this;
+    }
+
+    SJTU_CONSTEXPR20 reference operator*() const {
+      return vec_ptr_->Bit(index_);
+    }
+
+    SJTU_CONSTEXPR20 reference operator[](difference_type n) const {
+      return vec_ptr_->Bit(index_ + n);
+    }
+
+    SJTU_CONSTEXPR20 bool operator==(const Iterator &rhs) const {
+      return vec_ptr_ == rhs.vec_ptr_ && index_ == rhs.index_;
+    }
+
+    SJTU_CONSTEXPR20 bool operator!=(const Iterator &rhs) const {
+      return !(*this == rhs);
+    }
+
+    SJTU_CONSTEXPR20 bool operator<(const Iterator &rhs) const {
+      return index_ < rhs.index_;
+    }
+
+    SJTU_CONSTEXPR20 bool operator>(const Iterator &rhs) const {
+      return index_ > rhs.index_;
+    }
+
+    SJTU_CONSTEXPR20 bool operator<=(const Iterator &rhs) const {
+      return index_ <= rhs.index_;
+    }
+
+    SJTU_CONSTEXPR20 bool operator>=(const Iterator &rhs) const {
+      return index_ >= rhs.index_;
+    }
+  };
+
+public:
+  using value_type = bool;
+  using allocator_type = Allocator;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using const_reference = bool;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  SJTU_CONSTEXPR20 vector() : words_(), size_(0) {}
+
+  SJTU_CONSTEXPR20 explicit vector(const Allocator &alloc) : words_(WordAllocator(alloc)), size_(0) {}
+
+  SJTU_CONSTEXPR20 vector(size_t count, bool value, const Allocator &alloc = Allocator())
+      : words_(WordAllocator(alloc)), size_(0) {
+    assign(count, value);
+  }
+
+  SJTU_CONSTEXPR20 explicit vector(size_t count, const Allocator &alloc = Allocator())
+      : words_(WordCount(count), 0, WordAllocator(alloc)), size_(count) {}
+
+  template<class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  SJTU_CONSTEXPR20 vector(InputIt first, InputIt last, const Allocator &alloc = Allocator())
+      : words_(WordAllocator(alloc)), size_(0) {
+    for (; first != last; ++first) {
+      push_back(static_cast<bool>(*first));
+    }
+  }
+
+  vector(const vector &other) = default;
+
+  SJTU_CONSTEXPR20 vector(vector &&other) noexcept(std::is_nothrow_move_constructible<Words>::value)
+      : words_(std::move(other.words_)), size_(other.size_) {
+    other.size_ = 0;
+  }
+
+  SJTU_CONSTEXPR20 vector &operator=(const vector &other) {
+    if (this != &other) {
+      words_ = other.words_;
+      size_ = other.size_;
+    }
+    return *this;
+  }
+
+  SJTU_CONSTEXPR20 vector &operator=(vector &&other) {
+    if (this != &other) {
+      words_ = std::move(other.words_);
+      size_ = other.size_;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  SJTU_CONSTEXPR20 void swap(vector &other) {
+    words_.swap(other.words_);
+    std::swap(size_, other.size_);
+  }
+
+  friend SJTU_CONSTEXPR20 void swap(vector &lhs, vector &rhs) {
+    lhs.swap(rhs);
+  }
+
+  SJTU_CONSTEXPR20 Allocator get_allocator() const {
+    return Allocator(words_.get_allocator());
+  }
+
+  SJTU_CONSTEXPR20 void assign(size_t count, bool value) {
+    words_.assign(WordCount(count), value ? ~Word(0) : 0);
+    size_ = count;
+    ClearTail();
+  }
+
+  /**
+   * access specified element with bounds checking
+   * throw index_out_of_bound if pos is not in [0, size)
+   */
+  SJTU_CONSTEXPR20 reference at(const size_t &pos) {
+    if (pos >= size_) {
+      throw index_out_of_bound();
+    }
+    return Bit(pos);
+  }
+
+  SJTU_CONSTEXPR20 bool at(const size_t &pos) const {
+    if (pos >= size_) {
+      throw index_out_of_bound();
+    }
+    return Bit(pos);
+  }
+
+  SJTU_CONSTEXPR20 reference operator[](const size_t &pos) {
+    return at(pos);
+  }
+
+  SJTU_CONSTEXPR20 bool operator[](const size_t &pos) const {
+    return at(pos);
+  }
+
+  /**
+   * access the first / last element.
+   * throw container_is_empty if size == 0
+   */
+  SJTU_CONSTEXPR20 reference front() {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    return Bit(0);
+  }
+
+  SJTU_CONSTEXPR20 bool front() const {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    return Bit(0);
+  }
+
+  SJTU_CONSTEXPR20 reference back() {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    return Bit(size_ - 1);
+  }
+
+  SJTU_CONSTEXPR20 bool back() const {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    return Bit(size_ - 1);
+  }
+
+  SJTU_CONSTEXPR20 iterator begin() {
+    return {this, 0};
+  }
+
+  SJTU_CONSTEXPR20 const_iterator begin() const {
+    return {this, 0};
+  }
+
+  SJTU_CONSTEXPR20 const_iterator cbegin() const {
+    return {this, 0};
+  }
+
+  SJTU_CONSTEXPR20 iterator end() {
+    return {this, size_};
+  }
+
+  SJTU_CONSTEXPR20 const_iterator end() const {
+    return {this, size_};
+  }
+
+  SJTU_CONSTEXPR20 const_iterator cend() const {
+    return {this, size_};
+  }
+
+  SJTU_CONSTEXPR20 bool empty() const {
+    return size_ == 0;
+  }
+
+  SJTU_CONSTEXPR20 size_t size() const {
+    return size_;
+  }
+
+  SJTU_CONSTEXPR20 size_t capacity() const {
+    return words_.capacity() * kWordBits;
+  }
+
+  SJTU_CONSTEXPR20 void reserve(size_t new_cap) {
+    words_.reserve(WordCount(new_cap));
+  }
+
+  SJTU_CONSTEXPR20 void resize(size_t count, bool value = false) {
+    size_t old_size = size_;
+    words_.resize(WordCount(count), 0);
+    size_ = count;
+    if (count < old_size) {
+      ClearTail();
+    } else if (value) {
+      for (size_t i = old_size; i < count && i % kWordBits != 0; i++) {
+        Bit(i) = true;
+      }
+      for (size_t w = (old_size + kWordBits - 1) / kWordBits; w < words_.size(); w++) {
+        words_[w] = ~Word(0);
+      }
+      ClearTail();
+    }
+  }
+
+  SJTU_CONSTEXPR20 void shrink_to_fit() {
+    words_.shrink_to_fit();
+  }
+
+  SJTU_CONSTEXPR20 void clear() {
+    words_.clear();
+    size_ = 0;
+  }
+
+  /**
+   * inserts value before pos / at index ind, shifting the following flags a word at a time.
+   * throw index_out_of_bound if ind > size
+   */
+  SJTU_CONSTEXPR20 iterator insert(const_iterator pos, bool value) {
+    return insert(pos.index_, value);
+  }
+
+  SJTU_CONSTEXPR20 iterator insert(const size_t &ind, bool value) {
+    if (ind > size_) {
+      throw index_out_of_bound();
+    }
+    push_back(false);
+    Word *words = words_.data();
+    size_t wi = ind / kWordBits, last = words_.size() - 1;
+    for (size_t w = last; w > wi; w--) {
+      words[w] = (words[w] << 1) | (words[w - 1] >> (kWordBits - 1));
+    }
+    Word low = LowMask(ind % kWordBits);
+    words[wi] = (words[wi] & low) | ((words[wi] & ~low) << 1);
+    Bit(ind) = value;
+    return {this, ind};
+  }
+
+  /**
+   * removes the flag at pos / at index ind, shifting the following flags a word at a time.
+   * throw index_out_of_bound if ind >= size
+   */
+  SJTU_CONSTEXPR20 iterator erase(const_iterator pos) {
+    return erase(pos.index_);
+  }
+
+  SJTU_CONSTEXPR20 iterator erase(const size_t &ind) {
+    if (ind >= size_) {
+      throw index_out_of_bound();
+    }
+    Word *words = words_.data();
+    size_t wi = ind / kWordBits, last = words_.size() - 1;
+    Word low = LowMask(ind % kWordBits);
+    words[wi] = (words[wi] & low) | ((words[wi] >> 1) & ~low);
+    for (size_t w = wi + 1; w <= last; w++) {
+      words[w - 1] |= words[w] << (kWordBits - 1);
+      words[w] >>= 1;
+    }
+    size_--;
+    if (size_ % kWordBits == 0) {
+      words_.pop_back();
+    }
+    return {this, ind};
+  }
+
+  SJTU_CONSTEXPR20 void push_back(bool value) {
+    if (size_ % kWordBits == 0) {
+      words_.push_back(0);
+    }
+    size_++;
+    Bit(size_ - 1) = value;
+  }
+
+  /**
+   * throw container_is_empty if size() == 0
+   */
+  SJTU_CONSTEXPR20 void pop_back() {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    Bit(size_ - 1) = false;
+    size_--;
+    if (size_ % kWordBits == 0) {
+      words_.pop_back();
+    }
+  }
+
+  /**
+   * returns the number of set flags.
+   */
+  SJTU_CONSTEXPR20 size_t count() const {
+    const Word *words = words_.data();
+    size_t res = 0;
+    for (size_t w = 0; w < words_.size(); w++) {
+      res += __builtin_popcountll(words[w]);
+    }
+    return res;
+  }
+
+  /**
+   * returns the index of the first set flag, or size() if there is none.
+   */
+  SJTU_CONSTEXPR20 size_t find_first() const {
+    return FindFrom(0);
+  }
+
+  /**
+   * returns the index of the first set flag after pos, or size() if there is none.
+   */
+  SJTU_CONSTEXPR20 size_t find_next(size_t pos) const {
+    return pos + 1 >= size_ ? size_ : FindFrom(pos + 1);
+  }
+
+  /**
+   * inverts every flag.
+   */
+  SJTU_CONSTEXPR20 void flip() {
+    Word *words = words_.data();
+    for (size_t w = 0; w < words_.size(); w++) {
+      words[w] = ~words[w];
+    }
+    ClearTail();
+  }
+
+  /**
+   * combine the flags with those of rhs at the same index.
+   * throw runtime_error if the sizes differ
+   */
+  SJTU_CONSTEXPR20 vector &operator&=(const vector &rhs) {
+    return Combine(rhs, [](Word a, Word b) { return a & b; });
+  }
+
+  SJTU_CONSTEXPR20 vector &operator|=(const vector &rhs) {
+    return Combine(rhs, [](Word a, Word b) { return a | b; });
+  }
+
+  SJTU_CONSTEXPR20 vector &operator^=(const vector &rhs) {
+    return Combine(rhs, [](Word a, Word b) { return a ^ b; });
+  }
+
+  friend SJTU_CONSTEXPR20 vector operator&(vector lhs, const vector &rhs) {
+    return lhs &= rhs;
+  }
+
+  friend SJTU_CONSTEXPR20 vector operator|(vector lhs, const vector &rhs) {
+    return lhs |= rhs;
+  }
+
+  friend SJTU_CONSTEXPR20 vector operator^(vector lhs, const vector &rhs) {
+    return lhs ^= rhs;
+  }
+
+  SJTU_CONSTEXPR20 bool operator==(const vector &rhs) const {
+    if (size_ != rhs.size_) {
+      return false;
+    }
+    const Word *a = words_.data(), *b = rhs.words_.data();
+    for (size_t w = 0; w < words_.size(); w++) {
+      if (a[w] != b[w]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  SJTU_CONSTEXPR20 bool operator!=(const vector &rhs) const {
+    return !(*this == rhs);
+  }
+
+  /**
+   * the counters of the underlying word vector, so capacities are counted in 64-bit words.
+   */
+  SJTU_CONSTEXPR20 vector_stats stats() const {
+    return words_.stats();
+  }
+
+  SJTU_CONSTEXPR20 void reset_stats() {
+    words_.reset_stats();
+  }
+
+private:
+  static SJTU_CONSTEXPR20 size_t WordCount(size_t bits) {
+    return (bits + kWordBits - 1) / kWordBits;
+  }
+
+  // the bits below position n of a word.
+  static SJTU_CONSTEXPR20 Word LowMask(size_t n) {
+    return n == 0 ? 0 : ~Word(0) >> (kWordBits - n);
+  }
+
+  SJTU_CONSTEXPR20 reference Bit(size_t pos) {
+    return {words_.data() + pos / kWordBits, Word(1) << (pos % kWordBits)};
+  }
+
+  SJTU_CONSTEXPR20 bool Bit(size_t pos) const {
+    return (words_.data()[pos / kWordBits] >> (pos % kWordBits)) & 1;
+  }
+
+  SJTU_CONSTEXPR20 void ClearTail() {
+    if (size_ % kWordBits != 0) {
+      words_.data()[words_.size() - 1] &= LowMask(size_ % kWordBits);
+    }
+  }
+
+  SJTU_CONSTEXPR20 size_t FindFrom(size_t pos) const {
+    const Word *words = words_.data();
+    size_t w = pos / kWordBits;
+    if (w >= words_.size()) {
+      return size_;
+    }
+    Word cur = words[w] & ~LowMask(pos % kWordBits);
+    while (cur == 0) {
+      if (++w == words_.size()) {
+        return size_;
+      }
+      cur = words[w];
+    }
+    return w * kWordBits + __builtin_ctzll(cur);
+  }
+
+  template<class Op>
+  SJTU_CONSTEXPR20 vector &Combine(const vector &rhs, Op op) {
+    if (size_ != rhs.size_) {
+      throw runtime_error();
+    }
+    Word *a = words_.data();
+    const Word *b = rhs.words_.data();
+    for (size_t w = 0, n = words_.size(); w < n; w++) {
+      a[w] = op(a[w], b[w]);
+    }
+    return *this;
+  }
+
+  Words words_;
+  size_t size_;
+};
+
+/**
+ * a view of the elements of a sjtu::vector for hot loops.
+ * when NDEBUG is defined its element access is not bounds checked, so that loops over it can be vectorized;
+ *   otherwise it checks like vector and throws index_out_of_bound / container_is_empty.
+ * use unchecked_view<const T> (deduced from a const vector) for read-only access.
+ * the view is invalidated by every operation that invalidates the iterators of the vector.
+ */
+template<typename T>
+class unchecked_view {
+public:
+  using value_type = std::remove_const_t<T>;
+  using iterator = T *;
+
+  template<class Allocator, class GrowthPolicy, size_t N>
+  unchecked_view(vector<value_type, Allocator, GrowthPolicy, N> &vec) : first_(vec.data()), size_(vec.size()) {}
+
+  template<class Allocator, class GrowthPolicy, size_t N, class U = T,
+           class = std::enable_if_t<std::is_const<U>::value>>
+  unchecked_view(const vector<value_type, Allocator, GrowthPolicy, N> &vec)
+      : first_(vec.data()), size_(vec.size()) {}
+
+  T &operator[](size_t pos) const {
+#ifndef NDEBUG
+    if (pos >= size_) {
+      throw index_out_of_bound();
+    }
+#endif
+    return first_[pos];
+  }
+
+  T &front() const {
+#ifndef NDEBUG
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+#endif
+    return first_[0];
+  }
+
+  T &back() const {
+#ifndef NDEBUG
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+#endif
+    return first_[size_ - 1];
+  }
+
+  iterator begin() const {
+    return first_;
+  }
+
+  iterator end() const {
+    return first_ + size_;
+  }
+
+  T *data() const {
+    return first_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+private:
+  T *first_;
+  size_t size_;
+};
+
+template<typename T, typename Allocator, typename GrowthPolicy, size_t N>
+unchecked_view(vector<T, Allocator, GrowthPolicy, N> &) -> unchecked_view<T>;
+
+template<typename T, typename Allocator, typename GrowthPolicy, size_t N>
+unchecked_view(const vector<T, Allocator, GrowthPolicy, N> &) -> unchecked_view<const T>;
 
 }
 